@@ -0,0 +1,109 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "Benchmark.h"
+#include "Clock.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+void Benchmarks::Add(std::string const &name, BenchmarkFunction function, uint64_t items) {
+    this->entries.push_back({name, std::move(function), items});
+}
+
+static double TimeSample(BenchmarkFunction const &function, uint64_t iterations) {
+    Ticks start = ClockNow();
+    function(iterations);
+    return TicksToMilliseconds(ClockNow() - start);
+}
+
+static double Median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+
+std::vector<BenchmarkResult> Benchmarks::Run(BenchmarkOptions const &options) const {
+    std::vector<BenchmarkResult> results;
+
+    for (Entry const &entry : this->entries) {
+        if (entry.name.find(options.filter) == std::string::npos) continue;
+
+        /*
+         * grow the iteration count until a sample is long enough to time, then scale it to the sample length
+         */
+        uint64_t iterations = 1;
+        double elapsed = TimeSample(entry.function, iterations);
+        while (elapsed < options.sampleMilliseconds / 10.0 && iterations < (1ull << 40)) {
+            iterations *= 10;
+            elapsed = TimeSample(entry.function, iterations);
+        }
+        if (elapsed > 0.0) {
+            iterations = std::max<uint64_t>(1, (uint64_t) std::ceil((double) iterations * options.sampleMilliseconds / elapsed));
+        }
+
+        // caches, branch predictors and clocks settle before anything counts
+        for (double warm = 0.0; warm < options.warmupMilliseconds;) {
+            warm += TimeSample(entry.function, iterations);
+        }
+
+        std::vector<double> samples((size_t) std::max(options.repetitions, 1));
+        for (double &sample : samples) {
+            sample = TimeSample(entry.function, iterations) * 1e6 / (double) iterations;
+        }
+
+        BenchmarkResult result;
+        result.name = entry.name;
+        result.iterations = iterations;
+        result.repetitions = (int) samples.size();
+        result.medianNanoseconds = Median(samples);
+        result.minNanoseconds = *std::min_element(samples.begin(), samples.end());
+        result.maxNanoseconds = *std::max_element(samples.begin(), samples.end());
+
+        std::vector<double> deviations(samples.size());
+        for (size_t i = 0; i < samples.size(); ++i) deviations[i] = std::fabs(samples[i] - result.medianNanoseconds);
+        result.madNanoseconds = Median(deviations);
+
+        result.items = entry.items;
+        if (result.medianNanoseconds > 0.0) result.itemsPerSecond = (double) entry.items * 1e9 / result.medianNanoseconds;
+
+        printf("%-44s %14.2f ns  +- %10.2f  (%llu x %d)", result.name.c_str(), result.medianNanoseconds, result.madNanoseconds,
+               (unsigned long long) result.iterations, result.repetitions);
+        if (result.items > 1) printf("  %.2fM/s", result.itemsPerSecond / 1e6);
+        printf("\n");
+        fflush(stdout);
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+bool Benchmarks::WriteJSON(const char *path, std::vector<BenchmarkResult> const &results, BenchmarkOptions const &options) {
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+
+#ifdef NDEBUG
+    const char *optimized = "true";
+#else
+    const char *optimized = "false";
+#endif
+
+    fprintf(file, "{\n  \"context\": {\"repetitions\": %d, \"sample_ms\": %.3f, \"warmup_ms\": %.3f, \"optimized\": %s},\n",
+            options.repetitions, options.sampleMilliseconds, options.warmupMilliseconds, optimized);
+    fputs("  \"benchmarks\": [\n", file);
+
+    // names are ours and never need escaping
+    for (size_t i = 0; i < results.size(); ++i) {
+        BenchmarkResult const &result = results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"iterations\": %llu, \"repetitions\": %d, \"median_ns\": %.4f, \"mad_ns\": %.4f, "
+                      "\"min_ns\": %.4f, \"max_ns\": %.4f, \"items\": %llu, \"items_per_second\": %.1f}%s\n",
+                result.name.c_str(), (unsigned long long) result.iterations, result.repetitions, result.medianNanoseconds,
+                result.madNanoseconds, result.minNanoseconds, result.maxNanoseconds, (unsigned long long) result.items,
+                result.itemsPerSecond, i + 1 < results.size() ? "," : "");
+    }
+
+    fputs("  ]\n}\n", file);
+    return fclose(file) == 0;
+}
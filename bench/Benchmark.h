@@ -0,0 +1,80 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_BENCHMARK_H
+#define CUTLASS_BENCHMARK_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+ * a benchmark gets a number of iterations and runs its operation that many times. the harness picks the count so
+ * that one sample takes about CUT_BENCH_SAMPLE_MS, so timer overhead disappears.
+ */
+typedef std::function<void(uint64_t iterations)> BenchmarkFunction;
+
+#define CUT_BENCH_SAMPLE_MS 5.0
+#define CUT_BENCH_WARMUP_MS 100.0
+#define CUT_BENCH_REPETITIONS 25
+
+/*
+ * per operation times over all samples. median and MAD (median absolute deviation) rather than mean and standard
+ * deviation, one sample the scheduler got in the way of shouldn't move either.
+ */
+struct BenchmarkResult {
+    std::string name;
+    uint64_t iterations = 0;
+    int repetitions = 0;
+    double medianNanoseconds = 0.0;
+    double madNanoseconds = 0.0;
+    double minNanoseconds = 0.0;
+    double maxNanoseconds = 0.0;
+    // things one operation handles, e.g. rays cast. throughput is reported when there's more than one
+    uint64_t items = 1;
+    double itemsPerSecond = 0.0;
+};
+
+struct BenchmarkOptions {
+    // only benchmarks whose name contains this run
+    std::string filter;
+    int repetitions = CUT_BENCH_REPETITIONS;
+    double warmupMilliseconds = CUT_BENCH_WARMUP_MS;
+    double sampleMilliseconds = CUT_BENCH_SAMPLE_MS;
+};
+
+class Benchmarks {
+public:
+    void Add(std::string const &name, BenchmarkFunction function, uint64_t items = 1);
+
+    // prints every result as it comes in
+    std::vector<BenchmarkResult> Run(BenchmarkOptions const &options) const;
+
+    static bool WriteJSON(const char *path, std::vector<BenchmarkResult> const &results, BenchmarkOptions const &options);
+
+private:
+    struct Entry {
+        std::string name;
+        BenchmarkFunction function;
+        uint64_t items;
+    };
+
+    std::vector<Entry> entries;
+};
+
+/*
+ * keeps the compiler from optimising away work whose result nothing reads
+ */
+template<class T>
+inline void KeepAlive(T const &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile char sink;
+    sink = *(volatile const char *) &value;
+#endif
+}
+
+#endif //CUTLASS_BENCHMARK_H
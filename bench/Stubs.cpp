@@ -0,0 +1,135 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "Stubs.h"
+
+#include <algorithm>
+#include <cstring>
+
+uint64_t stubCalls = 0;
+
+struct StubUniform {
+    const char *name;
+    GLenum type;
+};
+
+// what the basic shaders declare, plus a few more so lookups aren't trivially short
+static StubUniform const stubUniforms[] = {
+        {"u_texture",    GL_SAMPLER_2D},
+        {"u_texture1",   GL_SAMPLER_2D},
+        {"u_model",      GL_FLOAT_MAT4},
+        {"u_view",       GL_FLOAT_MAT4},
+        {"u_projection", GL_FLOAT_MAT4},
+        {"u_normal",     GL_FLOAT_MAT3},
+        {"u_tint",       GL_FLOAT_VEC4},
+        {"u_light",      GL_FLOAT_VEC3},
+        {"u_offset",     GL_FLOAT_VEC2},
+        {"u_time",       GL_FLOAT},
+        {"u_lit",        GL_BOOL},
+};
+
+static GLuint nextName = 1;
+static std::vector<int> heldButtons;
+
+static GLuint APIENTRY StubCreate(GLenum) { ++stubCalls; return nextName++; }
+static GLuint APIENTRY StubCreateProgram() { ++stubCalls; return nextName++; }
+static void APIENTRY StubName(GLuint) { ++stubCalls; }
+static void APIENTRY StubNames(GLuint, GLuint) { ++stubCalls; }
+static void APIENTRY StubSource(GLuint, GLsizei, GLchar const *const *, GLint const *) { ++stubCalls; }
+static void APIENTRY StubLog(GLuint, GLsizei, GLsizei *length, GLchar *log) {
+    if (length) *length = 0;
+    if (log) *log = '\0';
+}
+
+static void APIENTRY StubShaderiv(GLuint, GLenum, GLint *value) { *value = GL_TRUE; }
+
+static void APIENTRY StubProgramiv(GLuint, GLenum name, GLint *value) {
+    switch (name) {
+        case GL_ACTIVE_UNIFORMS: *value = (GLint) ArrayLength(stubUniforms); break;
+        case GL_ACTIVE_UNIFORM_MAX_LENGTH: *value = 32; break;
+        case GL_ACTIVE_UNIFORM_BLOCKS: *value = 0; break;
+        default: *value = GL_TRUE; break;
+    }
+}
+
+static void APIENTRY StubActiveUniform(GLuint, GLuint index, GLsizei bufferSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+    StubUniform const &uniform = stubUniforms[index];
+    GLsizei copied = std::min((GLsizei) std::strlen(uniform.name), bufferSize - 1);
+    std::memcpy(name, uniform.name, (size_t) copied);
+    name[copied] = '\0';
+    if (length) *length = copied;
+    *size = 1;
+    *type = uniform.type;
+}
+
+static GLint APIENTRY StubUniformLocation(GLuint, GLchar const *name) {
+    for (size_t i = 0; i < ArrayLength(stubUniforms); ++i) {
+        if (std::strcmp(stubUniforms[i].name, name) == 0) return (GLint) i;
+    }
+    return -1;
+}
+
+static void APIENTRY StubUniform1i(GLint, GLint) { ++stubCalls; }
+static void APIENTRY StubUniform1f(GLint, GLfloat) { ++stubCalls; }
+static void APIENTRY StubUniformfv(GLint, GLsizei, GLfloat const *) { ++stubCalls; }
+static void APIENTRY StubUniformMatrixfv(GLint, GLsizei, GLboolean, GLfloat const *) { ++stubCalls; }
+static void APIENTRY StubProgramUniform1i(GLuint, GLint, GLint) { ++stubCalls; }
+static void APIENTRY StubProgramUniform1f(GLuint, GLint, GLfloat) { ++stubCalls; }
+static void APIENTRY StubProgramUniformfv(GLuint, GLint, GLsizei, GLfloat const *) { ++stubCalls; }
+static void APIENTRY StubProgramUniformMatrixfv(GLuint, GLint, GLsizei, GLboolean, GLfloat const *) { ++stubCalls; }
+
+void InstallStubGL(bool withDirectUniforms) {
+    SetStubDirectUniforms(withDirectUniforms);
+
+    glad_glCreateShader = StubCreate;
+    glad_glShaderSource = StubSource;
+    glad_glCompileShader = StubName;
+    glad_glGetShaderiv = StubShaderiv;
+    glad_glGetShaderInfoLog = StubLog;
+    glad_glDeleteShader = StubName;
+    glad_glCreateProgram = StubCreateProgram;
+    glad_glAttachShader = StubNames;
+    glad_glLinkProgram = StubName;
+    glad_glGetProgramiv = StubProgramiv;
+    glad_glGetProgramInfoLog = StubLog;
+    glad_glGetActiveUniform = StubActiveUniform;
+    glad_glGetUniformLocation = StubUniformLocation;
+    glad_glUseProgram = StubName;
+
+    glad_glUniform1i = StubUniform1i;
+    glad_glUniform1f = StubUniform1f;
+    glad_glUniform2fv = StubUniformfv;
+    glad_glUniform3fv = StubUniformfv;
+    glad_glUniform4fv = StubUniformfv;
+    glad_glUniformMatrix2fv = StubUniformMatrixfv;
+    glad_glUniformMatrix3fv = StubUniformMatrixfv;
+    glad_glUniformMatrix4fv = StubUniformMatrixfv;
+    glad_glProgramUniform1i = StubProgramUniform1i;
+    glad_glProgramUniform1f = StubProgramUniform1f;
+    glad_glProgramUniform2fv = StubProgramUniformfv;
+    glad_glProgramUniform3fv = StubProgramUniformfv;
+    glad_glProgramUniform4fv = StubProgramUniformfv;
+    glad_glProgramUniformMatrix2fv = StubProgramUniformMatrixfv;
+    glad_glProgramUniformMatrix3fv = StubProgramUniformMatrixfv;
+    glad_glProgramUniformMatrix4fv = StubProgramUniformMatrixfv;
+}
+
+void SetStubDirectUniforms(bool withDirectUniforms) {
+    GLAD_GL_VERSION_4_1 = withDirectUniforms;
+}
+
+void SetStubButtons(std::vector<int> const &held) {
+    heldButtons = held;
+}
+
+/*
+ * GLFW itself isn't linked into the benchmarks, these take the place of its input queries
+ */
+int glfwGetKey(GLFWwindow *, int key) {
+    return std::find(heldButtons.begin(), heldButtons.end(), key) != heldButtons.end() ? GLFW_PRESS : GLFW_RELEASE;
+}
+
+int glfwGetMouseButton(GLFWwindow *, int button) {
+    return std::find(heldButtons.begin(), heldButtons.end(), button) != heldButtons.end() ? GLFW_PRESS : GLFW_RELEASE;
+}
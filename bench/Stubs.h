@@ -0,0 +1,32 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_STUBS_H
+#define CUTLASS_STUBS_H
+
+#include <common.h>
+
+#include <cstdint>
+
+/*
+ * stand-ins for GL and GLFW, so the engine's CPU side can be timed without a context or a window
+ */
+
+// GL calls that reached the stub since the last reset
+extern uint64_t stubCalls;
+
+/*
+ * points glad at functions that do nothing but count. shaders "compile" from whatever source, and every program
+ * has the uniforms in StubUniforms(). withDirectUniforms pretends to be GL 4.1, where uniforms are set on a program
+ * without binding it.
+ */
+void InstallStubGL(bool withDirectUniforms);
+
+// switches an installed stub between the two ways of setting uniforms, without touching anything else
+void SetStubDirectUniforms(bool withDirectUniforms);
+
+// the keys glfwGetKey and glfwGetMouseButton report as held
+void SetStubButtons(std::vector<int> const &held);
+
+#endif //CUTLASS_STUBS_H
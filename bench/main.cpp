@@ -0,0 +1,483 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "Benchmark.h"
+#include "Stubs.h"
+#include "Input.h"
+#include "InterpolatedState.h"
+#include "SpatialIndex.h"
+#include "gameobjects/GameObject.h"
+#include "math/BoxTree.h"
+#include "math/Frustum.h"
+#include "math/MatrixKernels.h"
+#include "math/Transform.h"
+#include "math/TransformHierarchy.h"
+#include "render/Shader.h"
+#include <stb_image.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+
+/*
+ * times the engine's hot paths on their own. run it from the build directory, it reads shader/ and assets/ from
+ * there like the game does.
+ *
+ *     cutlass_bench [--filter name] [--repetitions N] [--warmup ms] [--sample ms] [--json results.json]
+ */
+
+static std::vector<Transform> MakeTransforms(size_t count) {
+    std::vector<Transform> transforms(count);
+    for (size_t i = 0; i < count; ++i) {
+        float f = (float) i;
+        transforms[i].SetPosition(glm::vec3(f, f * 0.5f, -f));
+        transforms[i].SetRotation(glm::vec3(f * 3.0f, f * 7.0f, f * 11.0f));
+        transforms[i].SetScale(glm::vec3(1.0f + f * 0.001f));
+    }
+    return transforms;
+}
+
+static void AddTransformBenchmarks(Benchmarks &benchmarks) {
+    auto transforms = std::make_shared<std::vector<Transform>>(MakeTransforms(1024));
+
+    // what a static object pays per frame
+    benchmarks.Add("transform/model_cached", [transforms](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) KeepAlive((*transforms)[i & 1023].Model());
+    });
+    // and one that moved
+    benchmarks.Add("transform/model_dirty", [transforms](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            Transform &transform = (*transforms)[i & 1023];
+            transform.SetPosition(transform.Position());
+            KeepAlive(transform.Model());
+        }
+    });
+}
+
+/*
+ * every kernel version the CPU runs, over 4096 transforms a call, so it's per matrix divided by 4096
+ */
+static void AddMatrixKernelBenchmarks(Benchmarks &benchmarks) {
+    auto transforms = std::make_shared<std::vector<Transform>>(MakeTransforms(4096));
+    auto models = std::make_shared<std::vector<glm::mat4>>(4096);
+    auto mvps = std::make_shared<std::vector<glm::mat4>>(4096);
+    glm::mat4 viewProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f)
+                               * glm::lookAt(glm::vec3(0.0f, 5.0f, 10.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    benchmarks.Add("matrix/model_4096/transform", [transforms, models](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            for (size_t t = 0; t < transforms->size(); ++t) {
+                Transform &transform = (*transforms)[t];
+                transform.SetPosition(transform.Position());
+                (*models)[t] = transform.Model();
+            }
+            KeepAlive((*models)[i & 4095]);
+        }
+    });
+
+    for (MatrixKernels const *kernels : SupportedMatrixKernels()) {
+        benchmarks.Add(std::string("matrix/model_4096/") + kernels->name, [kernels, transforms, models](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                kernels->buildModels(glm::value_ptr(models->front()), sizeof(glm::mat4),
+                                     reinterpret_cast<float const *>(transforms->data()), sizeof(Transform), transforms->size());
+                KeepAlive((*models)[i & 4095]);
+            }
+        });
+        benchmarks.Add(std::string("matrix/mvp_4096/") + kernels->name, [kernels, models, mvps, viewProjection](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                kernels->multiply(glm::value_ptr(mvps->front()), sizeof(glm::mat4), glm::value_ptr(viewProjection),
+                                  glm::value_ptr(models->front()), sizeof(glm::mat4), models->size());
+                KeepAlive((*mvps)[i & 4095]);
+            }
+        });
+    }
+}
+
+/*
+ * 10000 boxes spread around the camera, about a fifth of them in view
+ */
+static void AddCullingBenchmarks(Benchmarks &benchmarks) {
+    size_t const count = 10000;
+    auto bounds = std::make_shared<std::vector<float>>(count * 6);
+    auto visible = std::make_shared<std::vector<uint32_t>>(count);
+
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum(glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 200.0f) * view);
+
+    uint32_t seed = 1;
+    auto random = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return (float) (seed >> 8) / (float) (1u << 24);
+    };
+    for (size_t i = 0; i < count; ++i) {
+        for (int axis = 0; axis < 3; ++axis) {
+            (*bounds)[axis * count + i] = random() * 300.0f - 150.0f;
+            (*bounds)[(axis + 3) * count + i] = 0.5f + random() * 2.0f;
+        }
+    }
+
+    benchmarks.Add("cull/boxes_10000", [bounds, visible, frustum, count](uint64_t iterations) {
+        float const *b = bounds->data();
+        BoxArrays boxes = {{b, b + count, b + count * 2}, {b + count * 3, b + count * 4, b + count * 5}};
+        for (uint64_t i = 0; i < iterations; ++i) KeepAlive(CullBoxes(frustum, boxes, count, visible->data()));
+    });
+}
+
+/*
+ * the same 10000 boxes in a tree, a tenth of them moving every tick
+ */
+static void AddBoxTreeBenchmarks(Benchmarks &benchmarks) {
+    size_t const count = 10000;
+    auto tree = std::make_shared<BoxTree>();
+    auto boxes = std::make_shared<std::vector<Box>>(count);
+    auto proxies = std::make_shared<std::vector<BoxProxy>>(count);
+
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum(glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 200.0f) * view);
+
+    auto seed = std::make_shared<uint32_t>(1);
+    auto random = [seed]() {
+        *seed = *seed * 1664525u + 1013904223u;
+        return (float) (*seed >> 8) / (float) (1u << 24);
+    };
+    for (size_t i = 0; i < count; ++i) {
+        glm::vec3 center(random() * 300.0f - 150.0f, random() * 300.0f - 150.0f, random() * 300.0f - 150.0f);
+        glm::vec3 extents(0.5f + random() * 2.0f, 0.5f + random() * 2.0f, 0.5f + random() * 2.0f);
+        (*boxes)[i] = Box(center - extents, center + extents);
+        (*proxies)[i] = tree->Create((*boxes)[i], {(uint32_t) i, 0});
+    }
+
+    benchmarks.Add("boxtree/query_box", [tree](uint64_t iterations) {
+        Box area(glm::vec3(-20.0f), glm::vec3(20.0f));
+        for (uint64_t i = 0; i < iterations; ++i) {
+            uint32_t found = 0;
+            tree->Query(area, [&found](Entity, BoxProxy) { ++found; return true; });
+            KeepAlive(found);
+        }
+    });
+    benchmarks.Add("boxtree/query_frustum", [tree, frustum](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            uint32_t found = 0;
+            tree->Query(frustum, [&found](Entity, BoxProxy) { ++found; return true; });
+            KeepAlive(found);
+        }
+    });
+    benchmarks.Add("boxtree/raycast_nearest", [tree](uint64_t iterations) {
+        Ray ray(glm::vec3(-150.0f, 3.0f, -140.0f), glm::normalize(glm::vec3(1.0f, 0.0f, 0.9f)));
+        for (uint64_t i = 0; i < iterations; ++i) {
+            Entity nearest = CUT_NULL_ENTITY;
+            tree->RayCast(ray, 1000.0f, [&nearest](Entity entity, BoxProxy, float distance) {
+                nearest = entity;
+                return distance;
+            });
+            KeepAlive(nearest.index);
+        }
+    });
+    benchmarks.Add("boxtree/move_1000", [tree, boxes, proxies, random, count](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            for (size_t m = 0; m < 1000; ++m) {
+                size_t index = (size_t) (random() * (float) count) % count;
+                glm::vec3 step(random() - 0.5f, random() - 0.5f, random() - 0.5f);
+                Box &box = (*boxes)[index];
+                box = Box(box.min + step, box.max + step);
+                tree->Move((*proxies)[index], box, step);
+            }
+        }
+    });
+}
+
+/*
+ * 10000 crates of 16 to 64 units, about player sized, in a 4000 unit cube, hit by 256 rays at a time: a spread of shots from one point, and as
+ * many rays from all over going every which way, the worst case for packets
+ */
+static void AddRayBenchmarks(Benchmarks &benchmarks) {
+    size_t const count = 10000;
+    size_t const rayCount = 256;
+
+    Mesh crate;
+    for (int corner = 0; corner < 8; ++corner) {
+        Vertex vertex = {};
+        vertex.position = glm::vec3(corner & 1 ? 1.0f : -1.0f, corner & 2 ? 1.0f : -1.0f, corner & 4 ? 1.0f : -1.0f);
+        crate.vertices.push_back(vertex);
+    }
+    MeshHandle mesh = RegisterMesh(crate);
+
+    uint32_t seed = 1;
+    auto random = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return (float) (seed >> 8) / (float) (1u << 24);
+    };
+
+    World world;
+    for (size_t i = 0; i < count; ++i) {
+        Transform transform;
+        transform.SetPosition(glm::vec3(random() * 4000.0f - 2000.0f, random() * 4000.0f - 2000.0f, random() * 4000.0f - 2000.0f));
+        transform.SetRotation(glm::vec3(random() * 360.0f, random() * 360.0f, 0.0f));
+        transform.SetScale(glm::vec3(8.0f + random() * 24.0f));
+        world.Insert(world.Reserve(), transform, Renderable{mesh, 0, glm::vec4(1.0f)});
+    }
+    auto index = std::make_shared<SpatialIndex>();
+    index->Rebuild(world);
+
+    // within about 15 degrees of straight ahead
+    auto spread = std::make_shared<std::vector<Ray>>();
+    auto scattered = std::make_shared<std::vector<Ray>>();
+    for (size_t r = 0; r < rayCount; ++r) {
+        glm::vec3 direction(random() * 0.5f - 0.25f, random() * 0.5f - 0.25f, -1.0f);
+        spread->push_back(Ray(glm::vec3(0.0f), glm::normalize(direction)));
+
+        glm::vec3 origin(random() * 4000.0f - 2000.0f, random() * 4000.0f - 2000.0f, random() * 4000.0f - 2000.0f);
+        direction = glm::vec3(random() * 2.0f - 1.0f, random() * 2.0f - 1.0f, random() * 2.0f - 1.0f);
+        scattered->push_back(Ray(origin, glm::normalize(direction)));
+    }
+    auto hits = std::make_shared<std::vector<RayHit>>(rayCount);
+
+    for (auto const &set : {std::make_pair("spread", spread), std::make_pair("scattered", scattered)}) {
+        std::shared_ptr<std::vector<Ray>> rays = set.second;
+        std::string name = std::string("rays/") + set.first + "_" + std::to_string(rayCount);
+
+        benchmarks.Add(name + "/packets", [index, rays, hits](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) KeepAlive(index->CastRays(rays->data(), rays->size(), 4000.0f, hits->data()));
+        }, rayCount);
+        benchmarks.Add(name + "/single", [index, rays, hits](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                for (size_t r = 0; r < rays->size(); ++r) index->CastRay((*rays)[r], 4000.0f, (*hits)[r]);
+                KeepAlive(hits->back().distance);
+            }
+        }, rayCount);
+    }
+}
+
+/*
+ * 64 moving platforms with 256 props riding each
+ */
+static void AddHierarchyBenchmarks(Benchmarks &benchmarks) {
+    auto hierarchy = std::make_shared<TransformHierarchy>();
+    auto platforms = std::make_shared<std::vector<HierarchyNode>>();
+    std::vector<Transform> transforms = MakeTransforms(256);
+
+    for (uint32_t p = 0; p < 64; ++p) {
+        platforms->push_back(hierarchy->Add(transforms[p]));
+        for (Transform const &prop : transforms) hierarchy->Add(prop, platforms->back());
+    }
+    hierarchy->Update();
+
+    benchmarks.Add("hierarchy/moving_platforms", [hierarchy, platforms](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            for (HierarchyNode platform : *platforms) {
+                Transform moved = hierarchy->Local(platform);
+                moved.SetPosition(moved.Position() + glm::vec3(0.01f, 0.0f, 0.0f));
+                hierarchy->SetLocal(platform, moved);
+            }
+            hierarchy->Update();
+            KeepAlive(hierarchy->World(platforms->back() + 1));
+        }
+    });
+    benchmarks.Add("hierarchy/static", [hierarchy](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) hierarchy->Update();
+    });
+}
+
+/*
+ * a snapshot laid out like the ECS hands them over: runs of up to a chunk's worth of entities, all of them moving
+ */
+static void AddInterpolateBenchmarks(Benchmarks &benchmarks) {
+    for (size_t count : {10, 1000, 100000}) {
+        auto snapshot = std::make_shared<RenderSnapshot>();
+        snapshot->transforms = MakeTransforms(count);
+        snapshot->previousTransforms = MakeTransforms(count);
+        for (Transform &transform : snapshot->previousTransforms) transform.SetPosition(transform.Position() + glm::vec3(1.0f));
+
+        for (uint32_t begin = 0; begin < count; begin += 128) {
+            snapshot->ranges.push_back({begin, std::min<uint32_t>(128, (uint32_t) count - begin), true});
+        }
+        snapshot->player.position = glm::vec3(10.0f);
+
+        // everything in view, the most there is to interpolate
+        auto visible = std::make_shared<std::vector<uint32_t>>(count);
+        std::iota(visible->begin(), visible->end(), 0u);
+        auto models = std::make_shared<std::vector<glm::mat4>>(count);
+
+        auto interpolated = std::make_shared<InterpolatedState>();
+        benchmarks.Add("interpolate/" + std::to_string(count), [snapshot, interpolated, visible, models](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                float alpha = (float) (i & 63) / 64.0f;
+                InterpolateState(*interpolated, *snapshot, alpha);
+                InterpolateModels(models->data(), sizeof(glm::mat4), *interpolated, *snapshot, visible->data(), visible->size(), alpha);
+                KeepAlive(models->back());
+            }
+        });
+    }
+}
+
+static void AddInputBenchmarks(Benchmarks &benchmarks) {
+    // the game's bindings
+    auto buttons = std::make_shared<std::map<int, ButtonFlags>>(std::map<int, ButtonFlags>{
+            {GLFW_KEY_ESCAPE,         CUT_ESC},
+            {GLFW_KEY_SPACE,          CUT_JUMP},
+            {GLFW_KEY_W,              CUT_MOVE_FORWARD},
+            {GLFW_KEY_A,              CUT_MOVE_LEFT},
+            {GLFW_KEY_S,              CUT_MOVE_BACK},
+            {GLFW_KEY_D,              CUT_MOVE_RIGHT},
+            {GLFW_KEY_LEFT_CONTROL,   CUT_DUCK},
+            {GLFW_MOUSE_BUTTON_LEFT,  CUT_ATTACK},
+            {GLFW_MOUSE_BUTTON_RIGHT, CUT_ATTACK_ALT},
+            {GLFW_KEY_UP,             CUT_LOOK_UP},
+            {GLFW_KEY_LEFT,           CUT_LOOK_LEFT},
+            {GLFW_KEY_RIGHT,          CUT_LOOK_RIGHT},
+            {GLFW_KEY_DOWN,           CUT_LOOK_DOWN},
+    });
+
+    benchmarks.Add("input/scan_buttons", [buttons](uint64_t iterations) {
+        SetStubButtons({GLFW_KEY_W, GLFW_KEY_A, GLFW_MOUSE_BUTTON_LEFT});
+        for (uint64_t i = 0; i < iterations; ++i) KeepAlive(ScanButtons(nullptr, *buttons));
+    });
+}
+
+static void AddShaderBenchmarks(Benchmarks &benchmarks) {
+    glm::mat4 model = glm::translate(glm::mat4(), glm::vec3(1.0f, 2.0f, 3.0f));
+
+    // built once against the stub main() installed, so reading, compiling and reflecting it stays out of the samples
+    std::shared_ptr<Shader> shader;
+    try {
+        shader = std::make_shared<Shader>("shader/basic.vertex.glsl", "shader/basic.fragment.glsl");
+    }
+    catch (Error) {
+        std::cout << "Can't build the basic shader, skipping its benchmarks" << std::endl;
+        return;
+    }
+    auto uniform = std::make_shared<Uniform<glm::mat4>>(shader->Find<glm::mat4>("u_model"));
+
+    // pre 4.1 contexts bind the program around every set, 4.1 sets it on the program directly
+    for (bool direct : {false, true}) {
+        std::string suffix = direct ? "/direct" : "/bound";
+
+        benchmarks.Add("shader/set_mat4_by_name" + suffix, [shader, direct, model](uint64_t iterations) {
+            SetStubDirectUniforms(direct);
+            for (uint64_t i = 0; i < iterations; ++i) shader->SetMat4("u_model", model);
+        });
+        benchmarks.Add("shader/set_mat4_handle" + suffix, [shader, uniform, direct, model](uint64_t iterations) {
+            SetStubDirectUniforms(direct);
+            for (uint64_t i = 0; i < iterations; ++i) shader->Set(*uniform, model);
+        });
+        benchmarks.Add("shader/set_material" + suffix, [shader, direct](uint64_t iterations) {
+            SetStubDirectUniforms(direct);
+            for (uint64_t i = 0; i < iterations; ++i) {
+                shader->SetInt("u_texture", 0);
+                shader->SetInt("u_texture1", 1);
+                shader->SetVec4("u_tint", 1.0f, 1.0f, 1.0f, 1.0f);
+                shader->SetFloat("u_time", (float) i);
+            }
+        });
+    }
+
+    benchmarks.Add("shader/find", [shader](uint64_t iterations) {
+        std::string name = "u_tint";
+        for (uint64_t i = 0; i < iterations; ++i) KeepAlive(shader->Find<glm::vec4>(name).location);
+    });
+}
+
+/*
+ * decodes from memory, so disk speed doesn't count
+ */
+static void AddImageBenchmarks(Benchmarks &benchmarks) {
+    for (const char *path : {"assets/container.jpg", "assets/awesomeface.png"}) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            std::cout << "Can't read " << path << ", skipping its benchmark" << std::endl;
+            continue;
+        }
+        auto bytes = std::make_shared<std::vector<unsigned char>>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        benchmarks.Add(std::string("stb/decode/") + (path + 7), [bytes](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                int width, height, channels;
+                unsigned char *pixels = stbi_load_from_memory(bytes->data(), (int) bytes->size(), &width, &height, &channels, 0);
+                KeepAlive(pixels);
+                stbi_image_free(pixels);
+            }
+        });
+    }
+}
+
+static void AddGLMBenchmarks(Benchmarks &benchmarks) {
+    auto matrices = std::make_shared<std::vector<glm::mat4>>(256);
+    for (size_t i = 0; i < matrices->size(); ++i) {
+        (*matrices)[i] = glm::rotate(glm::translate(glm::mat4(), glm::vec3((float) i)), (float) i, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    benchmarks.Add("glm/mat4_mul", [matrices](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) KeepAlive((*matrices)[i & 255] * (*matrices)[(i + 1) & 255]);
+    });
+    benchmarks.Add("glm/mat4_vec4", [matrices](uint64_t iterations) {
+        glm::vec4 point(1.0f, 2.0f, 3.0f, 1.0f);
+        for (uint64_t i = 0; i < iterations; ++i) KeepAlive((*matrices)[i & 255] * point);
+    });
+    benchmarks.Add("glm/inverse", [matrices](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) KeepAlive(glm::inverse((*matrices)[i & 255]));
+    });
+    benchmarks.Add("glm/view_projection", [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            glm::vec3 eye((float) (i & 15), 1.0f, 5.0f);
+            glm::mat4 view = glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+            KeepAlive(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f) * view);
+        }
+    });
+
+}
+
+int main(int argc, char **argv) {
+    BenchmarkOptions options;
+    const char *jsonPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--filter" && hasValue) options.filter = argv[++i];
+        else if (arg == "--repetitions" && hasValue) options.repetitions = std::max(std::atoi(argv[++i]), 1);
+        else if (arg == "--warmup" && hasValue) options.warmupMilliseconds = std::atof(argv[++i]);
+        else if (arg == "--sample" && hasValue) options.sampleMilliseconds = std::max(std::atof(argv[++i]), 0.01);
+        else if (arg == "--json" && hasValue) jsonPath = argv[++i];
+        else std::cout << "Unknown argument: " << arg << std::endl;
+    }
+
+    // nothing here has a context, every GL call lands in a stub
+    InstallStubGL(false);
+
+    std::cout << "Matrix kernels: " << GetMatrixKernels().name << std::endl;
+
+    Benchmarks benchmarks;
+    AddTransformBenchmarks(benchmarks);
+    AddMatrixKernelBenchmarks(benchmarks);
+    AddHierarchyBenchmarks(benchmarks);
+    AddCullingBenchmarks(benchmarks);
+    AddBoxTreeBenchmarks(benchmarks);
+    AddRayBenchmarks(benchmarks);
+    AddInterpolateBenchmarks(benchmarks);
+    AddInputBenchmarks(benchmarks);
+    AddShaderBenchmarks(benchmarks);
+    AddImageBenchmarks(benchmarks);
+    AddGLMBenchmarks(benchmarks);
+
+    try {
+        std::vector<BenchmarkResult> results = benchmarks.Run(options);
+
+        if (jsonPath) {
+            if (!Benchmarks::WriteJSON(jsonPath, results, options)) {
+                std::cout << "Failed to write " << jsonPath << std::endl;
+                return CUT_ERROR_NO_FILE;
+            }
+            std::cout << "Wrote " << results.size() << " results to " << jsonPath << std::endl;
+        }
+    }
+    catch (Error error) {
+        std::cout << "There was a Cutlass Error (" << error << ")" << std::endl;
+        return error;
+    }
+    return CUT_NO_ERROR;
+}
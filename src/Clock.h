@@ -0,0 +1,36 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_CLOCK_H
+#define CUTLASS_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+/*
+ * integer nanosecond time. unlike float seconds from glfwGetTime this doesn't lose precision the longer the game
+ * runs, and sums of ticks are exact.
+ */
+typedef int64_t Ticks;
+
+#define CUT_TICKS_PER_SECOND 1000000000LL
+
+inline Ticks ClockNow() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline double TicksToSeconds(Ticks ticks) {
+    return (double) ticks / (double) CUT_TICKS_PER_SECOND;
+}
+
+inline double TicksToMilliseconds(Ticks ticks) {
+    return (double) ticks / (double) (CUT_TICKS_PER_SECOND / 1000);
+}
+
+inline Ticks SecondsToTicks(double seconds) {
+    return (Ticks) (seconds * (double) CUT_TICKS_PER_SECOND + 0.5);
+}
+
+#endif //CUTLASS_CLOCK_H
@@ -0,0 +1,127 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <thread>
+
+// never trust the scheduler to wake us up closer than this to a deadline
+#define CUT_MIN_SLEEP_SLACK (CUT_TICKS_PER_SECOND / 2000)
+#define CUT_MAX_SLEEP_SLACK (CUT_TICKS_PER_SECOND / 200)
+
+FramePacer::FramePacer(Ticks fixedStep, int targetFrameRate, int maxSubsteps)
+        : fixedStep(fixedStep),
+          framePeriod(targetFrameRate > 0 ? CUT_TICKS_PER_SECOND / targetFrameRate : 0),
+          maxSubsteps(std::max(maxSubsteps, 1)),
+          frameStart(0),
+          deadline(0),
+          accumulator(0),
+          simulationTime(0),
+          stepsLeft(0),
+          sleepSlack(CUT_TICKS_PER_SECOND / 1000) {
+
+}
+
+void FramePacer::BeginFrame() {
+    Ticks now = ClockNow();
+    Ticks elapsed = this->frameStart ? now - this->frameStart : 0;
+    this->frameStart = now;
+    if (!this->deadline) this->deadline = now;
+
+    this->report = FrameReport();
+    this->report.frames = 1;
+    this->report.frame = elapsed;
+
+    if (!this->fixedStep) return;
+
+    /*
+     * bound the catch up. whatever would take more than maxSubsteps is dropped, which dilates game time for the
+     * frame instead of making the next frame even longer.
+     */
+    this->accumulator += elapsed;
+    Ticks limit = this->fixedStep * this->maxSubsteps;
+    if (this->accumulator > limit) {
+        this->report.dropped = this->accumulator - limit;
+        this->accumulator = limit;
+    }
+
+    this->stepsLeft = (int) (this->accumulator / this->fixedStep);
+}
+
+bool FramePacer::Step() {
+    if (this->stepsLeft <= 0) return false;
+
+    --this->stepsLeft;
+    this->accumulator -= this->fixedStep;
+    this->simulationTime += this->fixedStep;
+
+    ++this->report.substeps;
+    this->report.simulated += this->fixedStep;
+
+    return true;
+}
+
+float FramePacer::Alpha() const {
+    if (!this->fixedStep) return 1.0f;
+    return (float) ((double) this->accumulator / (double) this->fixedStep);
+}
+
+void FramePacer::EndFrame() {
+    if (this->framePeriod) {
+        this->deadline += this->framePeriod;
+
+        // if we're more than a frame behind there's no catching up, so start pacing again from now
+        Ticks now = ClockNow();
+        if (now - this->deadline > this->framePeriod) {
+            this->deadline = now;
+        }
+
+        this->Wait(this->deadline);
+    }
+
+    this->totals.frames += this->report.frames;
+    this->totals.substeps += this->report.substeps;
+    this->totals.frame += this->report.frame;
+    this->totals.slept += this->report.slept;
+    this->totals.spun += this->report.spun;
+    this->totals.simulated += this->report.simulated;
+    this->totals.dropped += this->report.dropped;
+}
+
+FrameReport FramePacer::TakeTotals() {
+    FrameReport totals = this->totals;
+    this->totals = FrameReport();
+    return totals;
+}
+
+void FramePacer::Wait(Ticks until) {
+    Ticks now = ClockNow();
+
+    /*
+     * sleep through the bulk of the wait, keeping back however much the OS tends to oversleep by
+     */
+    Ticks sleepFor = until - now - this->sleepSlack;
+    if (sleepFor > 0) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(sleepFor));
+
+        Ticks woke = ClockNow();
+        Ticks overslept = (woke - now) - sleepFor;
+        this->sleepSlack += (overslept - this->sleepSlack) / 8;
+        this->sleepSlack = std::clamp<Ticks>(this->sleepSlack, CUT_MIN_SLEEP_SLACK, CUT_MAX_SLEEP_SLACK);
+
+        this->report.slept += woke - now;
+        now = woke;
+    }
+
+    /*
+     * then spin out the rest, yielding so we don't starve anything else that wants the core
+     */
+    Ticks spinStart = now;
+    while (now < until) {
+        std::this_thread::yield();
+        now = ClockNow();
+    }
+    this->report.spun += now - spinStart;
+}
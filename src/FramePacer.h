@@ -0,0 +1,84 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_FRAMEPACER_H
+#define CUTLASS_FRAMEPACER_H
+
+#include "Clock.h"
+
+/*
+ * where the time of a frame went. simulated is game time advanced by fixed steps, dropped is real time that was
+ * thrown away because the frame would have needed more than the maximum number of steps to catch up.
+ */
+struct FrameReport {
+    int frames = 0;
+    int substeps = 0;
+    Ticks frame = 0;
+    Ticks slept = 0;
+    Ticks spun = 0;
+    Ticks simulated = 0;
+    Ticks dropped = 0;
+};
+
+/*
+ * drives the fixed step loop and holds the frame rate to a target.
+ *
+ *     pacer.BeginFrame();
+ *     while (pacer.Step()) Update(...);
+ *     Render(..., pacer.Alpha());
+ *     pacer.EndFrame();
+ *
+ * waiting for the next frame sleeps for as long as the OS can be trusted to wake us up on time, and only spins for
+ * the last stretch. catch up is capped at maxSubsteps per frame; anything beyond that slows the game down for a
+ * moment instead of spiralling into ever longer frames.
+ */
+class FramePacer {
+public:
+    // a target frame rate of 0 doesn't wait at all, e.g. when vsync already paces us. a fixed step of 0 only paces
+    // frames and never steps, e.g. for a render loop that doesn't own the simulation.
+    FramePacer(Ticks fixedStep, int targetFrameRate, int maxSubsteps);
+
+    void BeginFrame();
+
+    // true while there's another fixed step to run this frame. advances the simulation clock.
+    bool Step();
+
+    // how far we are between the last fixed step and the next one, for interpolation
+    float Alpha() const;
+
+    // total game time simulated so far
+    Ticks SimulationTime() const { return this->simulationTime; }
+
+    // time accumulated towards the next fixed step
+    Ticks Remainder() const { return this->accumulator; }
+
+    // waits for the next frame and finishes off the frame's report
+    void EndFrame();
+
+    FrameReport const &Report() const { return this->report; }
+
+    // reports summed over all frames since the last call
+    FrameReport TakeTotals();
+
+private:
+    Ticks fixedStep;
+    Ticks framePeriod;
+    int maxSubsteps;
+
+    Ticks frameStart;
+    Ticks deadline;
+    Ticks accumulator;
+    Ticks simulationTime;
+    int stepsLeft;
+
+    // how late sleep_for tends to wake us up, learnt as we go
+    Ticks sleepSlack;
+
+    FrameReport report;
+    FrameReport totals;
+
+    void Wait(Ticks until);
+};
+
+#endif //CUTLASS_FRAMEPACER_H
@@ -3,3 +3,75 @@
 //
 
 #include "GameState.h"
+
+thread_local CommandBuffer *GameState::jobCommands = nullptr;
+SpatialIndex const *GameState::spatialIndex = nullptr;
+
+GameState::GameState() : buttonFlags(CUT_BUTTON_NONE), oldButtonFlags(CUT_BUTTON_NONE) {
+
+}
+
+static void SpawnObject(World &world, Entity entity, GameObject const &object) {
+    Transform const &transform = object;
+    Renderable renderable = {RegisterMesh(object.mesh), RegisterMaterial(object.material), object.tint};
+
+    if (object.fixedUpdate) {
+        world.Insert(entity, transform, renderable, Behaviour{object.fixedUpdate});
+    }
+    else {
+        world.Insert(entity, transform, renderable);
+    }
+}
+
+Entity GameState::PushObject(GameObject const &object) {
+    Transform const &transform = object;
+    // static objects never build their matrix again
+    transform.Model();
+
+    if (jobCommands) {
+        /*
+         * registering hands out the next free handle, so from a job it waits for playback, which runs the jobs'
+         * buffers in chunk order. registering here would number meshes in whatever order the jobs happened to run.
+         */
+        jobCommands->Defer([object](World &world) { SpawnObject(world, world.Reserve(), object); });
+        return CUT_NULL_ENTITY;
+    }
+
+    Entity entity = this->world.Reserve();
+    Renderable renderable = {RegisterMesh(object.mesh), RegisterMaterial(object.material), object.tint};
+
+    if (object.fixedUpdate) {
+        this->commands.Spawn(entity, transform, renderable, Behaviour{object.fixedUpdate});
+    }
+    else {
+        this->commands.Spawn(entity, transform, renderable);
+    }
+
+    return entity;
+}
+
+void GameState::RemoveObject(Entity entity) {
+    CommandBuffer &buffer = jobCommands ? *jobCommands : this->commands;
+    buffer.Destroy(entity);
+}
+
+void GameState::FlushCommands() {
+    this->commands.Playback(this->world);
+}
+
+void GameState::CatchUp(GameState const &newer) {
+    /*
+     * input and the player are small and written every frame, so they are always copied
+     */
+    this->mousePos = newer.mousePos;
+    this->deltaMousePos = newer.deltaMousePos;
+    this->deltaScroll = newer.deltaScroll;
+    this->buttonFlags = newer.buttonFlags;
+    this->oldButtonFlags = newer.oldButtonFlags;
+    this->player = newer.player;
+
+    /*
+     * entities only pay for the chunk columns that were written
+     */
+    this->world.CatchUp(newer.world);
+}
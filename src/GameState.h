@@ -5,4 +5,65 @@
 #ifndef CUTLASS_GAMESTATE_H
 #define CUTLASS_GAMESTATE_H
 
+#include <common.h>
+#include "ecs/CommandBuffer.h"
+#include "ecs/World.h"
+#include "gameobjects/Player.h"
+#include "gameobjects/GameObject.h"
+
+class SpatialIndex;
+
+enum ButtonFlags {
+    CUT_BUTTON_NONE = 0,
+    CUT_ESC = 1 << 0,
+    CUT_JUMP = 1 << 1,
+    CUT_MOVE_FORWARD = 1 << 2,
+    CUT_MOVE_LEFT = 1 << 3,
+    CUT_MOVE_BACK = 1 << 4,
+    CUT_MOVE_RIGHT = 1 << 5,
+    CUT_DUCK = 1 << 6,
+    CUT_ATTACK = 1 << 7,
+    CUT_ATTACK_ALT = 1 << 8,
+    CUT_LOOK_UP = 1 << 9,
+    CUT_LOOK_LEFT = 1 << 10,
+    CUT_LOOK_RIGHT = 1 << 11,
+    CUT_LOOK_DOWN = 1 << 12,
+};
+
+class GameState {
+public:
+    glm::vec2 mousePos;
+    glm::vec2 deltaMousePos;
+    glm::vec2 deltaScroll;
+    ButtonFlags buttonFlags;
+    ButtonFlags oldButtonFlags;
+
+    Player player;
+
+    World world;
+
+    // spawns and despawns requested during a tick, applied once the tick is done
+    CommandBuffer commands;
+
+    GameState();
+
+    // while set on a thread, PushObject and RemoveObject record into this buffer instead of commands. used by
+    // parallel updates, see Update.
+    static thread_local CommandBuffer *jobCommands;
+
+    // where everything renderable is, as of the end of the last tick. behaviours may query it, nothing changes it
+    // until the tick is over
+    static SpatialIndex const *spatialIndex;
+
+    // the returned handle is valid straight away, but the object only shows up in the world once the commands are
+    // flushed. safe to call while iterating the world. from inside a parallel update the entity, mesh and material
+    // handles are only handed out on playback, so this returns CUT_NULL_ENTITY.
+    Entity PushObject(GameObject const &object);
+    void RemoveObject(Entity entity);
+    void FlushCommands();
+
+    // brings this state up to date with a newer one by copying only what was written into it
+    void CatchUp(GameState const &newer);
+};
+
 #endif //CUTLASS_GAMESTATE_H
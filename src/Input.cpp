@@ -0,0 +1,15 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "Input.h"
+
+ButtonFlags ScanButtons(GLFWwindow *window, std::map<int, ButtonFlags> const &buttons) {
+    ButtonFlags flags = CUT_BUTTON_NONE;
+    for (auto const &[button, flag] : buttons) {
+        // glfwGetKey doesn't know about mouse buttons, their codes are all below the first key's
+        int state = button <= GLFW_MOUSE_BUTTON_LAST ? glfwGetMouseButton(window, button) : glfwGetKey(window, button);
+        if (state == GLFW_PRESS) flags |= flag;
+    }
+    return flags;
+}
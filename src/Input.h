@@ -0,0 +1,17 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_INPUT_H
+#define CUTLASS_INPUT_H
+
+#include <common.h>
+#include "GameState.h"
+
+/*
+ * the game's buttons that are held down right now. keys and mouse buttons can both be bound, anything at or below
+ * GLFW_MOUSE_BUTTON_LAST is taken to be a mouse button.
+ */
+ButtonFlags ScanButtons(GLFWwindow *window, std::map<int, ButtonFlags> const &buttons);
+
+#endif //CUTLASS_INPUT_H
@@ -0,0 +1,97 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "InterpolatedState.h"
+#include "Profiler.h"
+#include "render/AssetRegistry.h"
+
+#include <limits>
+
+void InterpolateState(InterpolatedState &interpolated, RenderSnapshot const &snapshot, float alpha) {
+    CUT_PROFILE("InterpolateState");
+
+    /*
+     * state interpolation is implementation specific, so this boiler plate doesn't do much other than interpolate
+     * the player and the camera. entities are left to InterpolateModels, once it's known which are drawn
+     */
+
+    /*
+     * interpolate player
+     */
+    Player const &previous = snapshot.previousPlayer;
+    auto player = snapshot.player;
+    if (player.position != previous.position) player.position = glm::mix(previous.position, player.position, alpha);
+    if (player.rotation != previous.rotation) player.rotation = glm::mix(previous.rotation, player.rotation, alpha);
+
+    /*
+     * interpolate player's camera
+     */
+    auto &camera = player.camera;
+    if (camera.position != previous.camera.position) camera.position = glm::mix(previous.camera.position, camera.position, alpha);
+    if (camera.rotation != previous.camera.rotation) camera.rotation = glm::mix(previous.camera.rotation, camera.rotation, alpha);
+
+    interpolated.player = player;
+}
+
+void InterpolateModels(glm::mat4 *out, size_t outStride, InterpolatedState &interpolated, RenderSnapshot const &snapshot,
+                       uint32_t const *visible, size_t count, float alpha) {
+    CUT_PROFILE("InterpolateModels");
+
+    auto model = [&](size_t i) -> glm::mat4 & { return *(glm::mat4 *) ((char *) out + i * outStride); };
+    Transform *mixed = interpolated.Scratch(count);
+
+    size_t i = 0;
+    for (SnapshotRange const &range : snapshot.ranges) {
+        uint32_t end = range.begin + range.count;
+        if (i == count) break;
+        if (visible[i] >= end) continue;
+
+        if (!range.moved) {
+            for (; i < count && visible[i] < end; ++i) model(i) = snapshot.transforms[visible[i]].Model();
+            continue;
+        }
+
+        // runs of neighbouring entities are mixed in one go, visible entities tend to come in long runs
+        while (i < count && visible[i] < end) {
+            size_t run = 1;
+            while (i + run < count && visible[i + run] == visible[i] + run && visible[i + run] < end) ++run;
+
+            MixTransforms(mixed, snapshot.previousTransforms.data() + visible[i], snapshot.transforms.data() + visible[i], run, alpha);
+            BuildModelMatrices(&model(i), outStride, mixed, run);
+            i += run;
+        }
+    }
+}
+
+void SnapshotBounds(RenderSnapshot const &snapshot, SnapshotRange const &range, uint32_t i, glm::vec3 &center, glm::vec3 &extents) {
+    Box const &local = GetMeshBounds(snapshot.renderables[i].mesh);
+    Transform const &transform = snapshot.transforms[i];
+
+    if (local.Empty()) {
+        center = transform.Position();
+        extents = glm::vec3(std::numeric_limits<float>::max());
+        return;
+    }
+
+    if (!range.moved) {
+        center = local.Center();
+        extents = local.Extents();
+        TransformBox(center, extents, transform.Model());
+        return;
+    }
+
+    /*
+     * the position moves in a straight line, and wherever the rotation is, the mesh stays within its bounds'
+     * radius of the position, times the biggest scale either end has. the scales mix linearly, so none in between
+     * is any bigger.
+     */
+    Transform const &previous = snapshot.previousTransforms[i];
+    glm::vec3 scale = glm::max(glm::abs(previous.Scale()), glm::abs(transform.Scale()));
+    float radius = glm::max(scale.x, glm::max(scale.y, scale.z)) * (glm::length(local.Center()) + glm::length(local.Extents()));
+
+    glm::vec3 low = glm::min(previous.Position(), transform.Position());
+    glm::vec3 high = glm::max(previous.Position(), transform.Position());
+    center = (low + high) * 0.5f;
+    extents = (high - low) * 0.5f + glm::vec3(radius);
+}
@@ -0,0 +1,46 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_INTERPOLATEDSTATE_H
+#define CUTLASS_INTERPOLATEDSTATE_H
+
+#include "RenderSnapshot.h"
+
+/*
+ * what the renderer needs from a render snapshot besides the snapshot itself: the interpolated player, and room to
+ * interpolate transforms in. transforms are only interpolated once culling has said which entities are drawn, see
+ * InterpolateModels.
+ */
+class InterpolatedState {
+public:
+    Player player;
+
+    // room for count interpolated transforms, reused from frame to frame
+    Transform *Scratch(size_t count) {
+        if (this->scratch.size() < count) this->scratch.resize(count);
+        return this->scratch.data();
+    }
+
+private:
+    std::vector<Transform> scratch;
+};
+
+// blends the snapshot's player and camera, alpha of the way from the previous tick to the current one
+void InterpolateState(InterpolatedState &interpolated, RenderSnapshot const &snapshot, float alpha);
+
+/*
+ * model matrices for the snapshot entities in visible, which is in ascending order. out[i] (every outStride bytes)
+ * belongs to visible[i]. entities whose range didn't move keep the matrix they have; the rest are interpolated
+ * like InterpolateState, but only those that are listed.
+ */
+void InterpolateModels(glm::mat4 *out, size_t outStride, InterpolatedState &interpolated, RenderSnapshot const &snapshot,
+                       uint32_t const *visible, size_t count, float alpha);
+
+/*
+ * a world space box around entity i of the snapshot. for an entity that moved it holds anywhere between the two
+ * ticks, whatever the alpha, so it can be culled before it's interpolated. meshes without bounds get an infinite box.
+ */
+void SnapshotBounds(RenderSnapshot const &snapshot, SnapshotRange const &range, uint32_t i, glm::vec3 &center, glm::vec3 &extents);
+
+#endif //CUTLASS_INTERPOLATEDSTATE_H
@@ -0,0 +1,287 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+Profiler profiler;
+
+static thread_local ProfileThread *currentThread = nullptr;
+
+/*
+ * a plain copy of an event, taken out of a ring
+ */
+struct ProfileRecord {
+    const char *name;
+    Ticks begin;
+    Ticks end;
+    uint32_t depth;
+};
+
+void ProfileThread::Write(const char *name, Ticks begin, Ticks end, uint32_t depth) {
+    uint64_t index = this->head.load(std::memory_order_relaxed);
+    ProfileEvent &event = this->events[index % CUT_PROFILER_EVENTS];
+    event.name.store(name, std::memory_order_relaxed);
+    event.begin.store(begin, std::memory_order_relaxed);
+    event.end.store(end, std::memory_order_relaxed);
+    event.depth.store(depth, std::memory_order_relaxed);
+    this->head.store(index + 1, std::memory_order_release);
+}
+
+/*
+ * copies out the events from index `from` on, at most a ring's worth, and returns where the next read should start.
+ * the writer may lap us while we copy, so whatever it could have overwritten by the time we're done is dropped.
+ */
+static uint64_t ReadEvents(ProfileThread const &thread, uint64_t from, std::vector<ProfileRecord> &records) {
+    uint64_t head = thread.head.load(std::memory_order_acquire);
+    if (head > CUT_PROFILER_EVENTS) from = std::max(from, head - CUT_PROFILER_EVENTS);
+
+    size_t first = records.size();
+    for (uint64_t i = from; i < head; ++i) {
+        ProfileEvent const &event = thread.events[i % CUT_PROFILER_EVENTS];
+        records.push_back({event.name.load(std::memory_order_relaxed), event.begin.load(std::memory_order_relaxed),
+                           event.end.load(std::memory_order_relaxed), event.depth.load(std::memory_order_relaxed)});
+    }
+
+    // event i is safe as long as the writer hasn't started on event i + CUT_PROFILER_EVENTS
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t after = thread.head.load(std::memory_order_relaxed);
+    if (after + 1 > from + CUT_PROFILER_EVENTS) {
+        size_t overwritten = (size_t) std::min<uint64_t>(after + 1 - CUT_PROFILER_EVENTS - from, head - from);
+        records.erase(records.begin() + first, records.begin() + first + overwritten);
+    }
+    return head;
+}
+
+Profiler::Profiler() {
+    this->start = ClockNow();
+    for (GPUFrame &frame : this->gpuFrames) frame = GPUFrame();
+}
+
+void Profiler::SetEnabled(bool enabled) {
+    if (enabled == this->Enabled()) return;
+
+    // the summary starts over, from whatever happens after this
+    if (enabled) {
+        std::lock_guard<std::mutex> lock(this->threadsMutex);
+        for (auto &thread : this->threads) thread->summarized = thread->head.load(std::memory_order_acquire);
+        this->summary.clear();
+        this->frameStart = 0;
+        this->averageFrame = 0.0;
+    }
+
+    this->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+ProfileThread *Profiler::Register() {
+    std::lock_guard<std::mutex> lock(this->threadsMutex);
+    this->threads.push_back(std::make_unique<ProfileThread>());
+    return this->threads.back().get();
+}
+
+ProfileThread &Profiler::Thread() {
+    if (!currentThread) currentThread = this->Register();
+    return *currentThread;
+}
+
+void Profiler::SetThreadName(const char *name) {
+    this->Thread().name.store(name, std::memory_order_relaxed);
+}
+
+void Profiler::InitGPU() {
+    // GL_TIME_ELAPSED queries came with 3.3
+    if (!GLAD_GL_VERSION_3_3 || this->gpu) return;
+
+    for (GPUFrame &frame : this->gpuFrames) {
+        glGenQueries(CUT_PROFILER_GPU_SCOPES, frame.queries);
+        frame.count = 0;
+    }
+
+    this->gpuThread = this->Register();
+    this->gpuThread->name.store("GPU", std::memory_order_relaxed);
+    this->gpu = true;
+}
+
+bool Profiler::BeginGPU(const char *name) {
+    if (!this->gpu || this->gpuOpen) return false;
+
+    GPUFrame &frame = this->gpuFrames[this->gpuFrame];
+    if (frame.count == CUT_PROFILER_GPU_SCOPES) return false;
+
+    frame.names[frame.count] = name;
+    frame.begins[frame.count] = ClockNow();
+    glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.count]);
+    this->gpuOpen = true;
+    return true;
+}
+
+void Profiler::EndGPU() {
+    glEndQuery(GL_TIME_ELAPSED);
+    ++this->gpuFrames[this->gpuFrame].count;
+    this->gpuOpen = false;
+}
+
+void Profiler::BeginFrame() {
+    if (!this->gpu) return;
+
+    /*
+     * the oldest frame's queries should long be done. if they aren't, the GPU is more than CUT_PROFILER_GPU_LATENCY
+     * frames behind and they're dropped rather than waited for.
+     */
+    this->gpuFrame = (this->gpuFrame + 1) % CUT_PROFILER_GPU_LATENCY;
+    GPUFrame &frame = this->gpuFrames[this->gpuFrame];
+    if (!frame.count) return;
+
+    // queries finish in order, so the last one being done means they all are
+    GLint available = 0;
+    glGetQueryObjectiv(frame.queries[frame.count - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+    if (available) {
+        Ticks now = ClockNow();
+        for (uint32_t i = 0; i < frame.count; ++i) {
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &elapsed);
+
+            // it can't have taken longer than it's been since, some drivers get a query's first result wrong
+            if ((Ticks) elapsed > now - frame.begins[i]) continue;
+
+            // the GPU clock isn't ours, so the scope goes where the CPU issued it
+            this->gpuThread->Write(frame.names[i], frame.begins[i], frame.begins[i] + (Ticks) elapsed, 0);
+        }
+    }
+    else {
+        ++this->gpuDropped;
+    }
+    frame.count = 0;
+}
+
+void Profiler::EndFrame() {
+    if (!this->Enabled()) return;
+
+    Ticks now = ClockNow();
+    if (this->frameStart) {
+        double frame = TicksToMilliseconds(now - this->frameStart);
+        this->averageFrame += (frame - this->averageFrame) / CUT_PROFILER_SUMMARY_FRAMES;
+    }
+    this->frameStart = now;
+
+    for (SummaryEntry &entry : this->summary) entry.frameMilliseconds = 0.0;
+
+    std::vector<ProfileRecord> records;
+    std::lock_guard<std::mutex> lock(this->threadsMutex);
+    for (auto &thread : this->threads) {
+        records.clear();
+        thread->summarized = ReadEvents(*thread, thread->summarized, records);
+
+        for (ProfileRecord const &record : records) {
+            auto found = std::find_if(this->summary.begin(), this->summary.end(), [&](SummaryEntry const &entry) {
+                return entry.thread == thread.get() && entry.name == record.name && entry.depth == record.depth;
+            });
+            if (found == this->summary.end()) {
+                this->summary.push_back({thread.get(), record.name, record.depth, record.begin, 0.0, 0.0});
+                found = this->summary.end() - 1;
+            }
+            found->frameMilliseconds += TicksToMilliseconds(record.end - record.begin);
+        }
+    }
+
+    // a scope that didn't run this frame counts as taking nothing, so the average tracks time per frame
+    for (SummaryEntry &entry : this->summary) {
+        entry.averageMilliseconds += (entry.frameMilliseconds - entry.averageMilliseconds) / CUT_PROFILER_SUMMARY_FRAMES;
+    }
+}
+
+std::string Profiler::Summary(size_t scopes) const {
+    std::vector<SummaryEntry const *> top;
+    for (SummaryEntry const &entry : this->summary) {
+        if (entry.depth == 0) top.push_back(&entry);
+    }
+    std::sort(top.begin(), top.end(), [](SummaryEntry const *a, SummaryEntry const *b) {
+        return a->averageMilliseconds > b->averageMilliseconds;
+    });
+    if (top.size() > scopes) top.resize(scopes);
+
+    char text[64];
+    snprintf(text, sizeof(text), "%.2fms", this->averageFrame);
+    std::string line = text;
+
+    for (SummaryEntry const *entry : top) {
+        snprintf(text, sizeof(text), " | %s%s %.2f", entry->thread == this->gpuThread ? "GPU " : "", entry->name, entry->averageMilliseconds);
+        line += text;
+    }
+    return line;
+}
+
+void Profiler::PrintSummary() const {
+    std::lock_guard<std::mutex> lock(this->threadsMutex);
+    std::cout << "Frame " << this->averageFrame << "ms" << std::endl;
+
+    for (size_t t = 0; t < this->threads.size(); ++t) {
+        ProfileThread const *thread = this->threads[t].get();
+
+        // scopes that started first come first, which puts every scope right under the one it's in
+        std::vector<SummaryEntry const *> entries;
+        for (SummaryEntry const &entry : this->summary) {
+            if (entry.thread == thread) entries.push_back(&entry);
+        }
+        if (entries.empty()) continue;
+        std::sort(entries.begin(), entries.end(), [](SummaryEntry const *a, SummaryEntry const *b) {
+            return a->firstBegin < b->firstBegin || (a->firstBegin == b->firstBegin && a->depth < b->depth);
+        });
+
+        const char *name = thread->name.load(std::memory_order_relaxed);
+        std::cout << (name ? name : "thread " + std::to_string(t)) << std::endl;
+        for (SummaryEntry const *entry : entries) {
+            std::cout << std::string(2 * (entry->depth + 1), ' ') << entry->name << " " << entry->averageMilliseconds << "ms" << std::endl;
+        }
+    }
+
+    if (this->gpuDropped) std::cout << this->gpuDropped << " frames of GPU timings were dropped, the GPU was too far behind" << std::endl;
+}
+
+static void WriteJSONString(FILE *file, const char *text) {
+    fputc('"', file);
+    for (const char *c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') fputc('\\', file);
+        if ((unsigned char) *c >= 0x20) fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+bool Profiler::WriteTrace(const char *path) const {
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+
+    std::lock_guard<std::mutex> lock(this->threadsMutex);
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+
+    bool first = true;
+    std::vector<ProfileRecord> records;
+    for (size_t t = 0; t < this->threads.size(); ++t) {
+        ProfileThread const &thread = *this->threads[t];
+        int tid = (int) t + 1;
+
+        const char *name = thread.name.load(std::memory_order_relaxed);
+        std::string threadName = name ? name : "thread " + std::to_string(t);
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", first ? "" : ",\n", tid);
+        WriteJSONString(file, threadName.c_str());
+        fputs("}}", file);
+        first = false;
+
+        // complete events, in microseconds since the profiler started
+        records.clear();
+        ReadEvents(thread, 0, records);
+        for (ProfileRecord const &record : records) {
+            fputs(",\n{\"name\":", file);
+            WriteJSONString(file, record.name);
+            fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", tid,
+                    (double) (record.begin - this->start) / 1000.0, (double) (record.end - record.begin) / 1000.0);
+        }
+    }
+
+    fputs("\n]}\n", file);
+    return fclose(file) == 0;
+}
@@ -0,0 +1,201 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_PROFILER_H
+#define CUTLASS_PROFILER_H
+
+#include <common.h>
+#include "Clock.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+// events kept per thread, older ones are overwritten
+#define CUT_PROFILER_EVENTS 16384
+// frames between issuing a GPU query and reading it back
+#define CUT_PROFILER_GPU_LATENCY 4
+#define CUT_PROFILER_GPU_SCOPES 32
+// how quickly the summary follows changes, about this many frames
+#define CUT_PROFILER_SUMMARY_FRAMES 30
+
+/*
+ * one finished scope. written by the thread it belongs to and read by whoever summarizes or dumps, so every field
+ * is atomic and a reader checks afterwards that the slot wasn't reused while it read.
+ */
+struct ProfileEvent {
+    std::atomic<const char *> name;
+    std::atomic<Ticks> begin;
+    std::atomic<Ticks> end;
+    std::atomic<uint32_t> depth;
+};
+
+/*
+ * a thread's events, a ring with a single writer. head only grows, event i lives in events[i % CUT_PROFILER_EVENTS].
+ */
+struct ProfileThread {
+    std::atomic<const char *> name{nullptr};
+    std::atomic<uint64_t> head{0};
+    ProfileEvent events[CUT_PROFILER_EVENTS];
+
+    // scopes open on the thread right now, only touched by the thread itself
+    uint32_t depth = 0;
+    // the next event the summary hasn't seen, only touched by the render thread
+    uint64_t summarized = 0;
+
+    void Write(const char *name, Ticks begin, Ticks end, uint32_t depth);
+};
+
+/*
+ * where the time of a frame goes, on every thread and on the GPU.
+ *
+ * CPU time is measured by ProfileScopes, which cost a relaxed load when the profiler is off (the default) and
+ * nothing at all when the game is built with CUT_NO_PROFILER. GPU time is measured by GPUProfileScopes with
+ * GL_TIME_ELAPSED queries, which are read back CUT_PROFILER_GPU_LATENCY frames later so the CPU never waits on them.
+ * those can't nest, a GPU scope inside another one is ignored.
+ *
+ *     void Render() {
+ *         CUT_PROFILE("Render");
+ *         CUT_PROFILE_GPU("Render");
+ *         ...
+ *     }
+ *
+ * the render thread calls BeginFrame() and EndFrame() around every frame; everything else is safe from any thread.
+ */
+class Profiler {
+public:
+    Profiler();
+
+    bool Enabled() const { return this->enabled.load(std::memory_order_relaxed); }
+    void SetEnabled(bool enabled);
+
+    // names the calling thread in traces
+    void SetThreadName(const char *name);
+
+    // needs a current context, without one only the CPU is profiled
+    void InitGPU();
+
+    // reads back the GPU scopes of CUT_PROFILER_GPU_LATENCY frames ago
+    void BeginFrame();
+    // adds the frame to the rolling summary
+    void EndFrame();
+
+    // one line with the frame time and the most expensive scopes that aren't inside another, for the window title
+    std::string Summary(size_t scopes = 4) const;
+    // every scope of every thread, indented by nesting
+    void PrintSummary() const;
+
+    // writes every event still in the buffers in Chrome's trace format, for chrome://tracing or ui.perfetto.dev
+    bool WriteTrace(const char *path) const;
+
+    // the calling thread's buffer, made on first use
+    ProfileThread &Thread();
+
+    bool BeginGPU(const char *name);
+    void EndGPU();
+
+private:
+    struct GPUFrame {
+        GLuint queries[CUT_PROFILER_GPU_SCOPES];
+        const char *names[CUT_PROFILER_GPU_SCOPES];
+        Ticks begins[CUT_PROFILER_GPU_SCOPES];
+        uint32_t count;
+    };
+
+    struct SummaryEntry {
+        ProfileThread const *thread;
+        const char *name;
+        uint32_t depth;
+        Ticks firstBegin;
+        double frameMilliseconds;
+        double averageMilliseconds;
+    };
+
+    std::atomic<bool> enabled{false};
+    Ticks start;
+
+    // every thread that has ever profiled anything. registering takes the lock, writing events never does
+    mutable std::mutex threadsMutex;
+    std::vector<std::unique_ptr<ProfileThread>> threads;
+
+    bool gpu = false;
+    bool gpuOpen = false;
+    uint32_t gpuFrame = 0;
+    uint32_t gpuDropped = 0;
+    GPUFrame gpuFrames[CUT_PROFILER_GPU_LATENCY];
+    ProfileThread *gpuThread = nullptr;
+
+    std::vector<SummaryEntry> summary;
+    Ticks frameStart = 0;
+    double averageFrame = 0.0;
+
+    ProfileThread *Register();
+};
+
+extern Profiler profiler;
+
+/*
+ * times the rest of the block it's declared in
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char *name) {
+        if (!profiler.Enabled()) return;
+
+        this->thread = &profiler.Thread();
+        this->name = name;
+        this->depth = this->thread->depth++;
+        this->begin = ClockNow();
+    }
+
+    ~ProfileScope() {
+        if (!this->thread) return;
+
+        --this->thread->depth;
+        this->thread->Write(this->name, this->begin, ClockNow(), this->depth);
+    }
+
+    ProfileScope(ProfileScope const &) = delete;
+    ProfileScope &operator=(ProfileScope const &) = delete;
+
+private:
+    ProfileThread *thread = nullptr;
+    const char *name = nullptr;
+    uint32_t depth = 0;
+    Ticks begin = 0;
+};
+
+/*
+ * times the GL commands issued in the rest of the block. render thread only
+ */
+class GPUProfileScope {
+public:
+    explicit GPUProfileScope(const char *name) {
+        this->active = profiler.Enabled() && profiler.BeginGPU(name);
+    }
+
+    ~GPUProfileScope() {
+        if (this->active) profiler.EndGPU();
+    }
+
+    GPUProfileScope(GPUProfileScope const &) = delete;
+    GPUProfileScope &operator=(GPUProfileScope const &) = delete;
+
+private:
+    bool active;
+};
+
+#define CUT_PROFILE_JOIN_(a, b) a##b
+#define CUT_PROFILE_JOIN(a, b) CUT_PROFILE_JOIN_(a, b)
+
+// names have to outlive the profiler, string literals do
+#ifdef CUT_NO_PROFILER
+#define CUT_PROFILE(name)
+#define CUT_PROFILE_GPU(name)
+#else
+#define CUT_PROFILE(name) ProfileScope CUT_PROFILE_JOIN(profileScope, __LINE__)(name)
+#define CUT_PROFILE_GPU(name) GPUProfileScope CUT_PROFILE_JOIN(gpuProfileScope, __LINE__)(name)
+#endif
+
+#endif //CUTLASS_PROFILER_H
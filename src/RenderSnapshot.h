@@ -0,0 +1,60 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_RENDERSNAPSHOT_H
+#define CUTLASS_RENDERSNAPSHOT_H
+
+#include "Clock.h"
+#include "gameobjects/GameObject.h"
+#include "gameobjects/Player.h"
+
+#include <algorithm>
+#include <vector>
+
+/*
+ * a run of entities that came out of the same chunk. previousTransforms is only filled in for runs that moved
+ * during the last tick; everything else looks the same in both states and doesn't need interpolating.
+ */
+struct SnapshotRange {
+    uint32_t begin;
+    uint32_t count;
+    bool moved;
+};
+
+/*
+ * everything the render thread needs from the last two ticks of the simulation, copied out so the simulation can
+ * get on with the next tick while the frame is drawn. entities, transforms and renderables are parallel arrays.
+ */
+struct RenderSnapshot {
+    // when the snapshot was published, and how much unsimulated time the pacer was holding on to at that point
+    Ticks published = 0;
+    Ticks remainder = 0;
+    Ticks fixedStep = 0;
+
+    Player previousPlayer;
+    Player player;
+
+    std::vector<Entity> entities;
+    std::vector<Transform> transforms;
+    std::vector<Transform> previousTransforms;
+    std::vector<Renderable> renderables;
+    std::vector<SnapshotRange> ranges;
+
+    void Clear() {
+        this->entities.clear();
+        this->transforms.clear();
+        this->previousTransforms.clear();
+        this->renderables.clear();
+        this->ranges.clear();
+    }
+
+    // interpolation factor for a frame drawn at now. holds at the newest state if the simulation falls behind.
+    float Alpha(Ticks now) const {
+        if (!this->fixedStep) return 1.0f;
+        double alpha = (double) (this->remainder + now - this->published) / (double) this->fixedStep;
+        return (float) std::clamp(alpha, 0.0, 1.0);
+    }
+};
+
+#endif //CUTLASS_RENDERSNAPSHOT_H
@@ -0,0 +1,159 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "SpatialIndex.h"
+#include "Profiler.h"
+#include "gameobjects/GameObject.h"
+
+#include <algorithm>
+
+/*
+ * the mesh's bounds in world space. meshes without bounds go in as a point at their origin
+ */
+static Box WorldBounds(Transform const &transform, Renderable const &renderable) {
+    Box const &local = GetMeshBounds(renderable.mesh);
+    if (local.Empty()) {
+        glm::vec3 origin = glm::vec3(transform.Model()[3]);
+        return Box(origin, origin);
+    }
+
+    glm::vec3 center = local.Center();
+    glm::vec3 extents = local.Extents();
+    TransformBox(center, extents, transform.Model());
+    return Box(center - extents, center + extents);
+}
+
+void SpatialIndex::Insert(Entity entity, Box const &box) {
+    if (entity.index >= this->proxies.size()) {
+        this->proxies.resize(entity.index + 1, CUT_NULL_PROXY);
+        this->centers.resize(entity.index + 1);
+        this->bounds.resize(entity.index + 1);
+    }
+    if (this->proxies[entity.index] != CUT_NULL_PROXY) return;
+
+    this->proxies[entity.index] = this->tree.Create(box, entity);
+    this->centers[entity.index] = box.Center();
+    this->bounds[entity.index] = box;
+}
+
+void SpatialIndex::Erase(Entity entity) {
+    if (entity.index >= this->proxies.size()) return;
+
+    BoxProxy &proxy = this->proxies[entity.index];
+    if (proxy == CUT_NULL_PROXY || this->tree.GetEntity(proxy) != entity) return;
+
+    this->tree.Destroy(proxy);
+    proxy = CUT_NULL_PROXY;
+}
+
+void SpatialIndex::Rebuild(World const &world) {
+    CUT_PROFILE("RebuildSpatialIndex");
+
+    this->tree = BoxTree();
+    this->proxies.clear();
+    this->centers.clear();
+    this->bounds.clear();
+
+    world.EachChunk(MaskOf<Transform, Renderable>(), [&](ChunkView const &chunk) {
+        Entity const *entities = chunk.Entities();
+        Transform const *transforms = chunk.Read<Transform>();
+        Renderable const *renderables = chunk.Read<Renderable>();
+        for (uint32_t i = 0; i < chunk.Count(); ++i) {
+            this->Insert(entities[i], WorldBounds(transforms[i], renderables[i]));
+        }
+    });
+}
+
+void SpatialIndex::Update(World const &world) {
+    CUT_PROFILE("UpdateSpatialIndex");
+
+    /*
+     * entities that came or went this tick. changes are in the order they were made, so a slot that was freed and
+     * handed out again is erased before its new entity goes in
+     */
+    ComponentMask required = MaskOf<Transform, Renderable>();
+    for (World::Change const &change : world.Changes()) {
+        if (change.type == World::CUT_CHANGE_DESTROY) {
+            this->Erase(change.entity);
+        }
+        else if (change.type == World::CUT_CHANGE_MOVE) {
+            if ((change.mask & required) != required) {
+                this->Erase(change.entity);
+            }
+            // it may have been moved again or destroyed later in the tick, what counts is where it is now
+            else if (world.IsAlive(change.entity) && world.Has<Transform>(change.entity) && world.Has<Renderable>(change.entity)) {
+                this->Insert(change.entity, WorldBounds(world.Get<Transform>(change.entity), world.Get<Renderable>(change.entity)));
+            }
+        }
+    }
+
+    // everything whose transform was written this tick, the rest of the world hasn't moved
+    world.EachChunk(required, [&](ChunkView const &chunk) {
+        if (chunk.Version<Transform>() != world.Tick()) return;
+
+        Entity const *entities = chunk.Entities();
+        Transform const *transforms = chunk.Read<Transform>();
+        Renderable const *renderables = chunk.Read<Renderable>();
+        for (uint32_t i = 0; i < chunk.Count(); ++i) {
+            uint32_t index = entities[i].index;
+            assert(index < this->proxies.size() && this->proxies[index] != CUT_NULL_PROXY && "entity missed by the index");
+            Box box = WorldBounds(transforms[i], renderables[i]);
+            glm::vec3 center = box.Center();
+
+            this->tree.Move(this->proxies[index], box, center - this->centers[index]);
+            this->centers[index] = center;
+            this->bounds[index] = box;
+        }
+    });
+}
+
+bool SpatialIndex::CastRay(Ray const &ray, float maxDistance, RayHit &hit) const {
+    hit = RayHit();
+    this->tree.RayCast(ray, maxDistance, [&](Entity entity, BoxProxy, float) {
+        // the tree's boxes are grown, only the entity's own bounds count as a hit
+        float distance;
+        glm::vec3 normal;
+        if (!ray.Intersects(this->bounds[entity.index], maxDistance, distance, normal)) return maxDistance;
+
+        hit = {entity, distance, normal};
+        maxDistance = distance;
+        return distance;
+    });
+    return hit.entity != CUT_NULL_ENTITY;
+}
+
+size_t SpatialIndex::CastRays(Ray const *rays, size_t count, float maxDistance, RayHit *hits) const {
+    CUT_PROFILE("CastRays");
+
+    size_t hitCount = 0;
+    for (size_t first = 0; first < count; first += CUT_RAY_PACKET) {
+        Ray const *packetRays = rays + first;
+        RayHit *packetHits = hits + first;
+        uint32_t lanes = (uint32_t) std::min<size_t>(count - first, CUT_RAY_PACKET);
+
+        RayPacket packet;
+        for (uint32_t lane = 0; lane < lanes; ++lane) {
+            packet.Set(lane, packetRays[lane], maxDistance);
+            packetHits[lane] = RayHit();
+        }
+
+        this->tree.RayCast(packet, [&](Entity entity, BoxProxy, uint32_t entered) {
+            // the lanes that got into the grown box, against the entity's own bounds. rare enough to go one by one
+            Box const &box = this->bounds[entity.index];
+            for (uint32_t lane = 0; lane < lanes; ++lane) {
+                if (!(entered & (1u << lane))) continue;
+
+                float distance;
+                glm::vec3 normal;
+                if (!packetRays[lane].Intersects(box, packet.maxDistance[lane], distance, normal)) continue;
+
+                packetHits[lane] = {entity, distance, normal};
+                packet.maxDistance[lane] = distance;
+            }
+        });
+
+        for (uint32_t lane = 0; lane < lanes; ++lane) hitCount += packetHits[lane].entity != CUT_NULL_ENTITY;
+    }
+    return hitCount;
+}
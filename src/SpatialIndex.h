@@ -0,0 +1,57 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_SPATIALINDEX_H
+#define CUTLASS_SPATIALINDEX_H
+
+#include <common.h>
+#include "ecs/World.h"
+#include "math/BoxTree.h"
+#include "math/RayPacket.h"
+
+/*
+ * a BoxTree over every entity with a Transform and a Renderable, in world space, kept up to date tick by tick.
+ *
+ * Update() is called once the tick's writes and command playback are done. it takes the tick's structural changes
+ * from the world, and otherwise only visits chunks whose Transform column was written this tick, so what it costs
+ * follows how much moved rather than how much there is. most of those moves stay inside their leaf's grown box and
+ * don't touch the tree at all.
+ *
+ * the tree is for the simulation thread, e.g. for behaviours asking what's near them: it's only changed between
+ * ticks, so reading it during one is safe from any job.
+ */
+class SpatialIndex {
+public:
+    // throws away the tree and builds it again from everything in the world, after loading or resetting it
+    void Rebuild(World const &world);
+    void Update(World const &world);
+
+    BoxTree const &Tree() const { return this->tree; }
+
+    // the entity's bounds in world space as of the last update, not grown like the tree's
+    Box const &Bounds(Entity entity) const { return this->bounds[entity.index]; }
+
+    // the nearest entity bounds the ray enters within maxDistance
+    bool CastRay(Ray const &ray, float maxDistance, RayHit &hit) const;
+
+    /*
+     * CastRay for many rays at once, CUT_RAY_PACKET at a time. rays next to each other in the array should head
+     * about the same way, like a weapon's spread or an AI's lines of sight, since a packet only goes as far into the
+     * tree as all of its rays together. returns how many rays hit something
+     */
+    size_t CastRays(Ray const *rays, size_t count, float maxDistance, RayHit *hits) const;
+
+private:
+    BoxTree tree;
+    // by entity index, CUT_NULL_PROXY when the entity isn't in the tree
+    std::vector<BoxProxy> proxies;
+    // where each entity's bounds were centered last tick, to tell the tree which way it's going
+    std::vector<glm::vec3> centers;
+    std::vector<Box> bounds;
+
+    void Insert(Entity entity, Box const &box);
+    void Erase(Entity entity);
+};
+
+#endif //CUTLASS_SPATIALINDEX_H
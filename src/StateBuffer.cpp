@@ -0,0 +1,22 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "StateBuffer.h"
+
+StateBuffer::StateBuffer() : current(&buffers[0]), previous(&buffers[1]) {
+
+}
+
+void StateBuffer::Reset() {
+    this->current->FlushCommands();
+    *this->previous = *this->current;
+    this->current->world.Follow(this->previous->world);
+}
+
+void StateBuffer::Advance() {
+    std::swap(this->current, this->previous);
+
+    // the buffer we are about to write into is one tick behind
+    this->current->CatchUp(*this->previous);
+}
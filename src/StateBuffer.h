@@ -0,0 +1,38 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_STATEBUFFER_H
+#define CUTLASS_STATEBUFFER_H
+
+#include "GameState.h"
+
+/*
+ * ping-pong store for the current and previous game state. instead of copying the whole world into the previous
+ * state before every fixed tick, the two buffers swap roles and the stale one is caught up with whatever the last
+ * tick wrote.
+ */
+class StateBuffer {
+public:
+    StateBuffer();
+    StateBuffer(StateBuffer const &) = delete;
+    StateBuffer &operator=(StateBuffer const &) = delete;
+
+    GameState &Current() { return *this->current; }
+    GameState const &Current() const { return *this->current; }
+    GameState const &Previous() const { return *this->previous; }
+
+    // makes both buffers equal to the current state. call after setting up the initial state.
+    void Reset();
+
+    // called before each fixed tick: the current state becomes the previous one and the new current state starts
+    // out equal to it.
+    void Advance();
+
+private:
+    GameState buffers[2];
+    GameState *current;
+    GameState *previous;
+};
+
+#endif //CUTLASS_STATEBUFFER_H
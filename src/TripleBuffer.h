@@ -0,0 +1,59 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_TRIPLEBUFFER_H
+#define CUTLASS_TRIPLEBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+/*
+ * hands values from one writer thread to one reader thread without either ever waiting on the other. the writer
+ * fills Back() and publishes it, the reader picks up whatever was published last with Update() and reads Front().
+ * if the writer publishes twice before the reader looks, the older value is simply overwritten.
+ *
+ * three slots are enough for that: one the writer owns, one the reader owns, and one waiting in the middle. which
+ * slot is in the middle, and whether it's newer than the reader's, is swapped in and out through a single atomic.
+ */
+template<class T>
+class TripleBuffer {
+public:
+    TripleBuffer() : ready(1), back(0), front(2) {}
+
+    TripleBuffer(TripleBuffer const &) = delete;
+    TripleBuffer &operator=(TripleBuffer const &) = delete;
+
+    // writer side
+    T &Back() { return this->slots[this->back]; }
+
+    void Publish() {
+        uint32_t previous = this->ready.exchange(this->back | CUT_TRIPLE_BUFFER_FRESH, std::memory_order_acq_rel);
+        this->back = previous & CUT_TRIPLE_BUFFER_SLOT;
+    }
+
+    // reader side. returns true if something new was published since the last call
+    bool Update() {
+        if (!(this->ready.load(std::memory_order_relaxed) & CUT_TRIPLE_BUFFER_FRESH)) return false;
+
+        uint32_t previous = this->ready.exchange(this->front, std::memory_order_acq_rel);
+        this->front = previous & CUT_TRIPLE_BUFFER_SLOT;
+        return true;
+    }
+
+    T const &Front() const { return this->slots[this->front]; }
+
+private:
+    static constexpr uint32_t CUT_TRIPLE_BUFFER_SLOT = 0x3;
+    static constexpr uint32_t CUT_TRIPLE_BUFFER_FRESH = 0x4;
+
+    T slots[3];
+
+    // the slot in the middle, plus the fresh bit
+    std::atomic<uint32_t> ready;
+
+    uint32_t back;
+    uint32_t front;
+};
+
+#endif //CUTLASS_TRIPLEBUFFER_H
@@ -26,10 +26,13 @@ enum Error {
     CUT_ERROR_NO_GLFW = 0x1000,
     CUT_ERROR_NO_GLAD = 0x1001,
     CUT_ERROR_NO_FILE = 0x1002,
+    CUT_ERROR_NO_HEADLESS = 0x1003,
+    CUT_ERROR_BAD_CAPTURE = 0x1004,
     CUT_ERROR_SHADER_FAIL = 0x2000,
     CUT_ERROR_PROGRAM_FAIL = 0x2001,
     CUT_ERROR_SHADER_FILE_NOT_READ = 0x2002,
     CUT_ASSETS_TEXTURE_NOT_READ = 0x3000,
+    CUT_ERROR_ASSET_LIMIT = 0x3001,
 };
 
 template<class T>
@@ -0,0 +1,211 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "Archetype.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#define CUT_CHUNK_ALIGNMENT 64
+
+static size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+Archetype::Archetype(ComponentMask mask) : mask(mask), capacity(0), chunkBytes(CUT_CHUNK_BYTES) {
+    std::fill(std::begin(this->columns), std::end(this->columns), (int8_t) CUT_NO_COLUMN);
+
+    for (ComponentId id = 0; id < CUT_MAX_COMPONENTS; ++id) {
+        if (mask & (ComponentMask(1) << id)) {
+            this->columns[id] = (int8_t) this->components.size();
+            this->components.push_back(id);
+        }
+    }
+
+    /*
+     * work out how many rows fit in a chunk. the entity column goes first, then one column per component, each
+     * starting on a 16 byte boundary so simd code can stream through them.
+     */
+    auto layout = [this](uint32_t rows, std::vector<uint32_t> &offsets) {
+        size_t bytes = sizeof(Entity) * rows;
+        offsets.clear();
+        for (ComponentId id : this->components) {
+            ComponentInfo const &info = GetComponentInfo(id);
+            bytes = AlignUp(bytes, std::max<size_t>(info.alignment, 16));
+            offsets.push_back((uint32_t) bytes);
+            bytes += info.size * rows;
+        }
+        return bytes;
+    };
+
+    size_t rowBytes = sizeof(Entity);
+    for (ComponentId id : this->components) {
+        rowBytes += GetComponentInfo(id).size;
+    }
+
+    this->capacity = (uint32_t) std::max<size_t>(1, CUT_CHUNK_BYTES / rowBytes);
+    while (this->capacity > 1 && layout(this->capacity, this->offsets) > CUT_CHUNK_BYTES) {
+        --this->capacity;
+    }
+
+    // a single row of huge components gets a chunk of its own, however large that is
+    this->chunkBytes = (uint32_t) AlignUp(std::max<size_t>(CUT_CHUNK_BYTES, layout(this->capacity, this->offsets)),
+                                          CUT_CHUNK_ALIGNMENT);
+}
+
+Archetype::Archetype(Archetype const &other) : mask(0), capacity(0), chunkBytes(0) {
+    this->CopyFrom(other);
+}
+
+Archetype::Archetype(Archetype &&other) noexcept
+        : mask(other.mask), components(std::move(other.components)), offsets(std::move(other.offsets)),
+          capacity(other.capacity), chunkBytes(other.chunkBytes), chunks(std::move(other.chunks)) {
+    std::copy(std::begin(other.columns), std::end(other.columns), std::begin(this->columns));
+    other.chunks.clear();
+}
+
+Archetype &Archetype::operator=(Archetype const &other) {
+    if (this != &other) {
+        this->Clear();
+        this->CopyFrom(other);
+    }
+    return *this;
+}
+
+Archetype &Archetype::operator=(Archetype &&other) noexcept {
+    if (this != &other) {
+        this->Clear();
+        this->mask = other.mask;
+        this->components = std::move(other.components);
+        this->offsets = std::move(other.offsets);
+        std::copy(std::begin(other.columns), std::end(other.columns), std::begin(this->columns));
+        this->capacity = other.capacity;
+        this->chunkBytes = other.chunkBytes;
+        this->chunks = std::move(other.chunks);
+        other.chunks.clear();
+    }
+    return *this;
+}
+
+Archetype::~Archetype() {
+    this->Clear();
+}
+
+uint32_t Archetype::Count() const {
+    if (this->chunks.empty()) return 0;
+    return (uint32_t) (this->chunks.size() - 1) * this->capacity + this->chunks.back().count;
+}
+
+void Archetype::PushRow(Entity entity, uint32_t &chunk, uint32_t &row, uint32_t tick) {
+    if (this->chunks.empty() || this->chunks.back().count == this->capacity) {
+        this->chunks.push_back(this->AllocateChunk());
+    }
+
+    chunk = (uint32_t) this->chunks.size() - 1;
+    Chunk &target = this->chunks[chunk];
+    row = target.count++;
+
+    this->Entities(target)[row] = entity;
+    for (int column = 0; column < (int) this->components.size(); ++column) {
+        GetComponentInfo(this->components[column]).construct(this->Element(target, column, row));
+    }
+
+    this->Touch(chunk, tick);
+}
+
+Entity Archetype::RemoveRow(uint32_t chunk, uint32_t row, uint32_t tick) {
+    Chunk &target = this->chunks[chunk];
+    Chunk &last = this->chunks.back();
+    uint32_t lastRow = last.count - 1;
+    bool removingLast = &target == &last && row == lastRow;
+
+    Entity moved = CUT_NULL_ENTITY;
+    if (!removingLast) {
+        // keep the archetype dense by filling the hole with its very last row
+        moved = this->Entities(last)[lastRow];
+        this->Entities(target)[row] = moved;
+        for (int column = 0; column < (int) this->components.size(); ++column) {
+            GetComponentInfo(this->components[column]).moveAssign(this->Element(target, column, row),
+                                                                  this->Element(last, column, lastRow));
+        }
+        this->Touch(chunk, tick);
+    }
+
+    for (int column = 0; column < (int) this->components.size(); ++column) {
+        GetComponentInfo(this->components[column]).destroy(this->Element(last, column, lastRow));
+    }
+
+    if (--last.count == 0) {
+        this->ReleaseChunk(last);
+        this->chunks.pop_back();
+    }
+
+    return moved;
+}
+
+void Archetype::Touch(uint32_t chunk, uint32_t tick) {
+    for (uint32_t &version : this->chunks[chunk].versions) {
+        version = tick;
+    }
+}
+
+Chunk Archetype::AllocateChunk() const {
+    Chunk chunk;
+    chunk.memory = static_cast<unsigned char *>(::operator new(this->chunkBytes, std::align_val_t(CUT_CHUNK_ALIGNMENT)));
+    chunk.count = 0;
+    chunk.versions.assign(this->components.size(), 0);
+    return chunk;
+}
+
+void Archetype::ReleaseChunk(Chunk &chunk) const {
+    for (int column = 0; column < (int) this->components.size(); ++column) {
+        ComponentInfo const &info = GetComponentInfo(this->components[column]);
+        if (info.trivial) continue;
+        for (uint32_t row = 0; row < chunk.count; ++row) {
+            info.destroy(this->Element(chunk, column, row));
+        }
+    }
+
+    ::operator delete(chunk.memory, std::align_val_t(CUT_CHUNK_ALIGNMENT));
+    chunk.memory = nullptr;
+    chunk.count = 0;
+}
+
+void Archetype::Clear() {
+    for (Chunk &chunk : this->chunks) {
+        this->ReleaseChunk(chunk);
+    }
+    this->chunks.clear();
+}
+
+void Archetype::CopyFrom(Archetype const &other) {
+    this->mask = other.mask;
+    this->components = other.components;
+    this->offsets = other.offsets;
+    std::copy(std::begin(other.columns), std::end(other.columns), std::begin(this->columns));
+    this->capacity = other.capacity;
+    this->chunkBytes = other.chunkBytes;
+
+    this->chunks.reserve(other.chunks.size());
+    for (Chunk const &source : other.chunks) {
+        Chunk chunk = this->AllocateChunk();
+        chunk.count = source.count;
+        chunk.versions = source.versions;
+
+        std::memcpy(this->Entities(chunk), other.Entities(source), sizeof(Entity) * source.count);
+        for (int column = 0; column < (int) this->components.size(); ++column) {
+            ComponentInfo const &info = GetComponentInfo(this->components[column]);
+            if (info.trivial) {
+                std::memcpy(this->Column(chunk, column), other.Column(source, column), info.size * source.count);
+                continue;
+            }
+            for (uint32_t row = 0; row < source.count; ++row) {
+                info.copyConstruct(this->Element(chunk, column, row), other.Element(source, column, row));
+            }
+        }
+
+        this->chunks.push_back(std::move(chunk));
+    }
+}
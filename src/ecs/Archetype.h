@@ -0,0 +1,73 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_ARCHETYPE_H
+#define CUTLASS_ARCHETYPE_H
+
+#include "ecs/Component.h"
+#include "ecs/Entity.h"
+
+#include <vector>
+
+#define CUT_CHUNK_BYTES (16 * 1024)
+#define CUT_NO_COLUMN (-1)
+
+/*
+ * a fixed size block holding up to an archetype's capacity of entities. each component is stored as its own
+ * contiguous column, and each column remembers the tick it was last written on.
+ */
+struct Chunk {
+    unsigned char *memory;
+    uint32_t count;
+    std::vector<uint32_t> versions;
+};
+
+/*
+ * every entity with exactly the same set of components lives in the same archetype, packed densely into chunks.
+ * all chunks but the last are always full.
+ */
+class Archetype {
+public:
+    ComponentMask mask;
+    std::vector<ComponentId> components;
+    std::vector<uint32_t> offsets;
+    int8_t columns[CUT_MAX_COMPONENTS];
+    uint32_t capacity;
+    uint32_t chunkBytes;
+    std::vector<Chunk> chunks;
+
+    explicit Archetype(ComponentMask mask);
+    Archetype(Archetype const &other);
+    Archetype(Archetype &&other) noexcept;
+    Archetype &operator=(Archetype const &other);
+    Archetype &operator=(Archetype &&other) noexcept;
+    ~Archetype();
+
+    uint32_t Count() const;
+
+    Entity *Entities(Chunk const &chunk) const { return reinterpret_cast<Entity *>(chunk.memory); }
+    void *Column(Chunk const &chunk, int column) const { return chunk.memory + this->offsets[column]; }
+    void *Element(Chunk const &chunk, int column, uint32_t row) const {
+        return static_cast<unsigned char *>(this->Column(chunk, column))
+               + row * GetComponentInfo(this->components[column]).size;
+    }
+
+    // appends a default constructed row for the entity
+    void PushRow(Entity entity, uint32_t &chunk, uint32_t &row, uint32_t tick);
+
+    // removes a row by moving the last row of the archetype into it. returns the entity that was moved into the
+    // hole, or CUT_NULL_ENTITY if the removed row was the last one.
+    Entity RemoveRow(uint32_t chunk, uint32_t row, uint32_t tick);
+
+    // marks every column of a chunk as written on the given tick
+    void Touch(uint32_t chunk, uint32_t tick);
+
+private:
+    Chunk AllocateChunk() const;
+    void ReleaseChunk(Chunk &chunk) const;
+    void Clear();
+    void CopyFrom(Archetype const &other);
+};
+
+#endif //CUTLASS_ARCHETYPE_H
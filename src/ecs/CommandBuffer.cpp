@@ -0,0 +1,16 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "CommandBuffer.h"
+
+void CommandBuffer::Destroy(Entity entity) {
+    this->commands.push_back([entity](World &world) { world.Destroy(entity); });
+}
+
+void CommandBuffer::Playback(World &world) {
+    for (auto &command : this->commands) {
+        command(world);
+    }
+    this->commands.clear();
+}
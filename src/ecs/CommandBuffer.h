@@ -0,0 +1,50 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_COMMANDBUFFER_H
+#define CUTLASS_COMMANDBUFFER_H
+
+#include "ecs/World.h"
+
+#include <functional>
+#include <utility>
+
+/*
+ * structural changes queued while a world is being iterated, applied in order by Playback once iteration is done.
+ * entities spawned through here should be reserved on the world first so their handle can be used straight away.
+ * spawning CUT_NULL_ENTITY reserves the handle on playback instead, which keeps handles deterministic when several
+ * buffers are filled in parallel and played back in a fixed order.
+ */
+class CommandBuffer {
+public:
+    template<typename... Ts>
+    void Spawn(Entity entity, Ts const &... components) {
+        this->commands.push_back([entity, components...](World &world) {
+            world.Insert(entity == CUT_NULL_ENTITY ? world.Reserve() : entity, components...);
+        });
+    }
+
+    template<typename T>
+    void Add(Entity entity, T const &component) {
+        this->commands.push_back([entity, component](World &world) { world.Add(entity, component); });
+    }
+
+    template<typename T>
+    void Remove(Entity entity) {
+        this->commands.push_back([entity](World &world) { world.Remove<T>(entity); });
+    }
+
+    void Destroy(Entity entity);
+
+    // anything else that has to happen in playback order
+    void Defer(std::function<void(World &)> command) { this->commands.push_back(std::move(command)); }
+
+    void Playback(World &world);
+    bool Empty() const { return this->commands.empty(); }
+
+private:
+    std::vector<std::function<void(World &)>> commands;
+};
+
+#endif //CUTLASS_COMMANDBUFFER_H
@@ -0,0 +1,31 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "Component.h"
+
+#include <atomic>
+#include <cassert>
+#include <mutex>
+
+// fixed storage so lookups never race with a registration growing the table
+static ComponentInfo registry[CUT_MAX_COMPONENTS];
+static std::atomic<ComponentId> registryCount(0);
+static std::mutex registryMutex;
+
+ComponentId RegisterComponent(ComponentInfo const &info) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    ComponentId id = registryCount.load();
+    assert(id < CUT_MAX_COMPONENTS && "too many component types");
+
+    registry[id] = info;
+    registryCount.store(id + 1);
+
+    return id;
+}
+
+ComponentInfo const &GetComponentInfo(ComponentId id) {
+    assert(id < registryCount.load());
+    return registry[id];
+}
@@ -0,0 +1,59 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_COMPONENT_H
+#define CUTLASS_COMPONENT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#define CUT_MAX_COMPONENTS 64
+
+typedef uint32_t ComponentId;
+typedef uint64_t ComponentMask;
+
+/*
+ * type erased operations on a component, so chunks can construct, copy, move and destroy columns of any type
+ */
+struct ComponentInfo {
+    size_t size;
+    size_t alignment;
+    bool trivial;
+    void (*construct)(void *target);
+    void (*copyConstruct)(void *target, const void *source);
+    void (*copyAssign)(void *target, const void *source);
+    void (*moveAssign)(void *target, void *source);
+    void (*destroy)(void *target);
+};
+
+ComponentId RegisterComponent(ComponentInfo const &info);
+ComponentInfo const &GetComponentInfo(ComponentId id);
+
+/*
+ * ids are handed out the first time a type is used, and are shared by every world
+ */
+template<typename T>
+ComponentId ComponentType() {
+    static const ComponentId id = RegisterComponent(ComponentInfo{
+            sizeof(T),
+            alignof(T),
+            std::is_trivially_copyable<T>::value,
+            [](void *target) { new(target) T(); },
+            [](void *target, const void *source) { new(target) T(*static_cast<const T *>(source)); },
+            [](void *target, const void *source) { *static_cast<T *>(target) = *static_cast<const T *>(source); },
+            [](void *target, void *source) { *static_cast<T *>(target) = std::move(*static_cast<T *>(source)); },
+            [](void *target) { static_cast<T *>(target)->~T(); },
+    });
+    return id;
+}
+
+template<typename... Ts>
+ComponentMask MaskOf() {
+    return (ComponentMask(0) | ... | (ComponentMask(1) << ComponentType<Ts>()));
+}
+
+#endif //CUTLASS_COMPONENT_H
@@ -0,0 +1,24 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_ENTITY_H
+#define CUTLASS_ENTITY_H
+
+#include <cstdint>
+
+/*
+ * generational handle to an entity. the index names a slot in the world's entity table, the generation is bumped
+ * every time that slot is freed so stale handles can be told apart from the entity that reuses the slot.
+ */
+struct Entity {
+    uint32_t index;
+    uint32_t generation;
+
+    bool operator==(Entity const &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(Entity const &other) const { return !(*this == other); }
+};
+
+constexpr Entity CUT_NULL_ENTITY = {0xFFFFFFFF, 0};
+
+#endif //CUTLASS_ENTITY_H
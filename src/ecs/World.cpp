@@ -0,0 +1,184 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "World.h"
+
+#include <cstring>
+
+World::World() : tick(1) {
+
+}
+
+Entity World::Reserve() {
+    uint32_t index;
+    if (!this->freeList.empty()) {
+        index = this->freeList.back();
+        this->freeList.pop_back();
+    }
+    else {
+        index = (uint32_t) this->records.size();
+        this->records.push_back(Record{0, CUT_NO_ARCHETYPE, 0, 0});
+    }
+
+    Entity entity = {index, this->records[index].generation};
+    this->changes.push_back(Change{CUT_CHANGE_RESERVE, entity, 0});
+
+    return entity;
+}
+
+void World::Destroy(Entity entity) {
+    if (!this->IsAlive(entity)) return;
+
+    this->MoveEntity(entity, 0);
+
+    // stale handles to this slot stop resolving from here on
+    ++this->records[entity.index].generation;
+    this->freeList.push_back(entity.index);
+    this->changes.push_back(Change{CUT_CHANGE_DESTROY, entity, 0});
+}
+
+bool World::IsAlive(Entity entity) const {
+    return entity.index < this->records.size() && this->records[entity.index].generation == entity.generation;
+}
+
+uint32_t World::Count() const {
+    uint32_t count = 0;
+    for (Archetype const &archetype : this->archetypes) {
+        count += archetype.Count();
+    }
+    return count;
+}
+
+void World::CatchUp(World const &newer) {
+    uint32_t since = this->tick;
+
+    /*
+     * both worlds started the tick with the same layout, so replaying the same structural changes in the same
+     * order puts every entity in the same chunk and row as it is in the newer world
+     */
+    for (Change const &change : newer.changes) {
+        switch (change.type) {
+            case CUT_CHANGE_RESERVE: {
+                [[maybe_unused]] Entity entity = this->Reserve();
+                assert(entity == change.entity && "worlds diverged");
+                break;
+            }
+            case CUT_CHANGE_MOVE:
+                this->SetMask(change.entity, change.mask);
+                break;
+            case CUT_CHANGE_DESTROY:
+                this->Destroy(change.entity);
+                break;
+        }
+    }
+
+    assert(this->archetypes.size() == newer.archetypes.size());
+
+    /*
+     * then copy the columns the newer world wrote since we were last in step
+     */
+    for (size_t a = 0; a < this->archetypes.size(); ++a) {
+        Archetype &archetype = this->archetypes[a];
+        Archetype const &source = newer.archetypes[a];
+        assert(archetype.chunks.size() == source.chunks.size());
+
+        for (size_t c = 0; c < archetype.chunks.size(); ++c) {
+            Chunk &chunk = archetype.chunks[c];
+            Chunk const &sourceChunk = source.chunks[c];
+            assert(chunk.count == sourceChunk.count);
+
+            for (int column = 0; column < (int) archetype.components.size(); ++column) {
+                if (sourceChunk.versions[column] <= since) continue;
+
+                ComponentInfo const &info = GetComponentInfo(archetype.components[column]);
+                if (info.trivial) {
+                    std::memcpy(archetype.Column(chunk, column), source.Column(sourceChunk, column),
+                                info.size * chunk.count);
+                }
+                else {
+                    for (uint32_t row = 0; row < chunk.count; ++row) {
+                        info.copyAssign(archetype.Element(chunk, column, row),
+                                        source.Element(sourceChunk, column, row));
+                    }
+                }
+                chunk.versions[column] = sourceChunk.versions[column];
+            }
+        }
+    }
+
+    this->Follow(newer);
+}
+
+void World::Follow(World const &older) {
+    this->tick = older.tick + 1;
+    this->changes.clear();
+}
+
+World::Record const &World::Find(Entity entity) const {
+    assert(this->IsAlive(entity));
+    Record const &record = this->records[entity.index];
+    assert(record.archetype != CUT_NO_ARCHETYPE && "entity has no components yet");
+    return record;
+}
+
+ComponentMask World::MaskOfEntity(Entity entity) const {
+    if (!this->IsAlive(entity)) return 0;
+    uint32_t archetype = this->records[entity.index].archetype;
+    return archetype == CUT_NO_ARCHETYPE ? 0 : this->archetypes[archetype].mask;
+}
+
+uint32_t World::FindOrCreateArchetype(ComponentMask mask) {
+    auto found = this->archetypeLookup.find(mask);
+    if (found != this->archetypeLookup.end()) return found->second;
+
+    uint32_t index = (uint32_t) this->archetypes.size();
+    this->archetypes.emplace_back(mask);
+    this->archetypeLookup[mask] = index;
+
+    return index;
+}
+
+void World::SetMask(Entity entity, ComponentMask mask) {
+    if (!this->IsAlive(entity) || this->MaskOfEntity(entity) == mask) return;
+
+    this->MoveEntity(entity, mask);
+    this->changes.push_back(Change{CUT_CHANGE_MOVE, entity, mask});
+}
+
+void World::MoveEntity(Entity entity, ComponentMask mask) {
+    Record &record = this->records[entity.index];
+    uint32_t archetype = CUT_NO_ARCHETYPE, chunk = 0, row = 0;
+
+    if (mask) {
+        archetype = this->FindOrCreateArchetype(mask);
+
+        Archetype &to = this->archetypes[archetype];
+        to.PushRow(entity, chunk, row, this->tick);
+
+        // carry over whatever components the entity keeps
+        if (record.archetype != CUT_NO_ARCHETYPE) {
+            Archetype &from = this->archetypes[record.archetype];
+            for (int column = 0; column < (int) to.components.size(); ++column) {
+                int fromColumn = from.columns[to.components[column]];
+                if (fromColumn == CUT_NO_COLUMN) continue;
+
+                GetComponentInfo(to.components[column]).moveAssign(
+                        to.Element(to.chunks[chunk], column, row),
+                        from.Element(from.chunks[record.chunk], fromColumn, record.row));
+            }
+        }
+    }
+
+    if (record.archetype != CUT_NO_ARCHETYPE) {
+        Entity moved = this->archetypes[record.archetype].RemoveRow(record.chunk, record.row, this->tick);
+        if (moved != CUT_NULL_ENTITY) {
+            this->records[moved.index].chunk = record.chunk;
+            this->records[moved.index].row = record.row;
+        }
+    }
+
+    record.archetype = archetype;
+    record.chunk = chunk;
+    record.row = row;
+}
@@ -0,0 +1,283 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_WORLD_H
+#define CUTLASS_WORLD_H
+
+#include "ecs/Archetype.h"
+
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+
+#define CUT_NO_ARCHETYPE 0xFFFFFFFF
+
+/*
+ * a view of one chunk handed out while iterating. reads are free, writes stamp the column with the world's tick so
+ * anything tracking changes (the state buffer, interpolation) can skip columns nobody touched.
+ */
+class ChunkView {
+public:
+    ChunkView(Archetype *archetype, Chunk *chunk, uint32_t tick) : archetype(archetype), chunk(chunk), tick(tick) {}
+
+    uint32_t Count() const { return this->chunk->count; }
+    Entity const *Entities() const { return this->archetype->Entities(*this->chunk); }
+
+    template<typename T>
+    bool Has() const {
+        return this->archetype->columns[ComponentType<T>()] != CUT_NO_COLUMN;
+    }
+
+    template<typename T>
+    T const *Read() const {
+        int column = this->archetype->columns[ComponentType<T>()];
+        assert(column != CUT_NO_COLUMN);
+        return static_cast<T const *>(this->archetype->Column(*this->chunk, column));
+    }
+
+    template<typename T>
+    T *Write() {
+        int column = this->archetype->columns[ComponentType<T>()];
+        assert(column != CUT_NO_COLUMN);
+        this->chunk->versions[column] = this->tick;
+        return static_cast<T *>(this->archetype->Column(*this->chunk, column));
+    }
+
+    // the tick the column was last written on
+    template<typename T>
+    uint32_t Version() const {
+        int column = this->archetype->columns[ComponentType<T>()];
+        assert(column != CUT_NO_COLUMN);
+        return this->chunk->versions[column];
+    }
+
+    // const components are read, everything else is written
+    template<typename T>
+    auto Column() {
+        if constexpr (std::is_const<T>::value) return this->Read<std::remove_const_t<T>>();
+        else return this->Write<T>();
+    }
+
+private:
+    Archetype *archetype;
+    Chunk *chunk;
+    uint32_t tick;
+};
+
+/*
+ * entity/component store. components live in archetype chunks, entities are generational handles into an entity
+ * table. structural changes (Insert, Add, Remove, Destroy) move rows between chunks and must not happen while
+ * iterating; queue them on a CommandBuffer instead. Reserve is the exception and can be called at any time.
+ */
+class World {
+public:
+    enum ChangeType {
+        CUT_CHANGE_RESERVE,
+        CUT_CHANGE_MOVE,
+        CUT_CHANGE_DESTROY,
+    };
+
+    // a structural change. a move is to the archetype with the given mask, a mask of 0 means no components
+    struct Change {
+        ChangeType type;
+        Entity entity;
+        ComponentMask mask;
+    };
+
+    World();
+
+    // hands out a handle straight away. the entity has no components until something is inserted for it.
+    Entity Reserve();
+
+    template<typename... Ts>
+    void Insert(Entity entity, Ts const &... components);
+
+    template<typename T>
+    void Add(Entity entity, T const &component) { this->Insert(entity, component); }
+
+    template<typename T>
+    void Remove(Entity entity);
+
+    void Destroy(Entity entity);
+
+    bool IsAlive(Entity entity) const;
+
+    template<typename T>
+    bool Has(Entity entity) const;
+
+    template<typename T>
+    T const &Get(Entity entity) const;
+
+    // marks the entity's chunk column as written
+    template<typename T>
+    T &Write(Entity entity);
+
+    // calls func(ChunkView &) for every chunk that has all of the required components
+    template<typename Func>
+    void EachChunk(ComponentMask required, Func &&func);
+
+    template<typename Func>
+    void EachChunk(ComponentMask required, Func &&func) const;
+
+    /*
+     * walks this world's chunks alongside another world's. func(ChunkView const &chunk, ChunkView const *other) is given
+     * the other world's chunk when it holds exactly the same entities in the same rows, and nullptr otherwise.
+     */
+    template<typename Func>
+    void EachChunkPair(World const &other, ComponentMask required, Func &&func) const;
+
+    // calls func(Entity, Ts &...) for every entity with all of Ts. const components are read only.
+    template<typename... Ts, typename Func>
+    void Each(Func &&func);
+
+    uint32_t Count() const;
+    uint32_t Tick() const { return this->tick; }
+
+    /*
+     * brings this world up to date with a newer copy of itself that was one tick ahead of it: replays the newer
+     * world's structural changes, then copies only the chunk columns written since this world's tick.
+     */
+    void CatchUp(World const &newer);
+
+    // starts recording writes against the tick after the given world's
+    void Follow(World const &older);
+
+    // the structural changes made since the tick started, in the order they were made
+    std::vector<Change> const &Changes() const { return this->changes; }
+
+private:
+    struct Record {
+        uint32_t generation;
+        uint32_t archetype;
+        uint32_t chunk;
+        uint32_t row;
+    };
+
+    std::vector<Record> records;
+    std::vector<uint32_t> freeList;
+    std::vector<Archetype> archetypes;
+    std::unordered_map<ComponentMask, uint32_t> archetypeLookup;
+    std::vector<Change> changes;
+    uint32_t tick;
+
+    Record const &Find(Entity entity) const;
+    ComponentMask MaskOfEntity(Entity entity) const;
+    uint32_t FindOrCreateArchetype(ComponentMask mask);
+    void MoveEntity(Entity entity, ComponentMask mask);
+    void SetMask(Entity entity, ComponentMask mask);
+
+    template<typename Func, typename... Ps>
+    static void EachRow(ChunkView &chunk, Func &func, Ps *... columns) {
+        Entity const *entities = chunk.Entities();
+        for (uint32_t row = 0; row < chunk.Count(); ++row) {
+            func(entities[row], columns[row]...);
+        }
+    }
+};
+
+template<typename... Ts>
+void World::Insert(Entity entity, Ts const &... components) {
+    this->SetMask(entity, this->MaskOfEntity(entity) | MaskOf<Ts...>());
+    ((this->Write<Ts>(entity) = components), ...);
+}
+
+template<typename T>
+void World::Remove(Entity entity) {
+    this->SetMask(entity, this->MaskOfEntity(entity) & ~MaskOf<T>());
+}
+
+template<typename T>
+bool World::Has(Entity entity) const {
+    return this->MaskOfEntity(entity) & MaskOf<T>();
+}
+
+template<typename T>
+T const &World::Get(Entity entity) const {
+    Record const &record = this->Find(entity);
+    Archetype const &archetype = this->archetypes[record.archetype];
+    int column = archetype.columns[ComponentType<T>()];
+    assert(column != CUT_NO_COLUMN);
+    return *static_cast<T const *>(archetype.Element(archetype.chunks[record.chunk], column, record.row));
+}
+
+template<typename T>
+T &World::Write(Entity entity) {
+    Record const &record = this->Find(entity);
+    Archetype &archetype = this->archetypes[record.archetype];
+    int column = archetype.columns[ComponentType<T>()];
+    assert(column != CUT_NO_COLUMN);
+    Chunk &chunk = archetype.chunks[record.chunk];
+    chunk.versions[column] = this->tick;
+    return *static_cast<T *>(archetype.Element(chunk, column, record.row));
+}
+
+template<typename Func>
+void World::EachChunk(ComponentMask required, Func &&func) {
+    for (Archetype &archetype : this->archetypes) {
+        if ((archetype.mask & required) != required) continue;
+        for (Chunk &chunk : archetype.chunks) {
+            ChunkView view(&archetype, &chunk, this->tick);
+            func(view);
+        }
+    }
+}
+
+template<typename Func>
+void World::EachChunk(ComponentMask required, Func &&func) const {
+    for (Archetype const &archetype : this->archetypes) {
+        if ((archetype.mask & required) != required) continue;
+        for (Chunk const &chunk : archetype.chunks) {
+            ChunkView const view(const_cast<Archetype *>(&archetype), const_cast<Chunk *>(&chunk), this->tick);
+            func(view);
+        }
+    }
+}
+
+template<typename Func>
+void World::EachChunkPair(World const &other, ComponentMask required, Func &&func) const {
+    for (size_t a = 0; a < this->archetypes.size(); ++a) {
+        Archetype const &archetype = this->archetypes[a];
+        if ((archetype.mask & required) != required) continue;
+
+        // archetypes are only ever appended, so the same index means the same archetype in both worlds
+        Archetype const *otherArchetype = nullptr;
+        if (a < other.archetypes.size() && other.archetypes[a].mask == archetype.mask) {
+            otherArchetype = &other.archetypes[a];
+        }
+
+        for (size_t c = 0; c < archetype.chunks.size(); ++c) {
+            Chunk const &chunk = archetype.chunks[c];
+            ChunkView const view(const_cast<Archetype *>(&archetype), const_cast<Chunk *>(&chunk), this->tick);
+
+            Chunk const *otherChunk = nullptr;
+            if (otherArchetype && c < otherArchetype->chunks.size()) {
+                Chunk const &candidate = otherArchetype->chunks[c];
+                if (candidate.count == chunk.count &&
+                    std::memcmp(archetype.Entities(chunk), otherArchetype->Entities(candidate),
+                                sizeof(Entity) * chunk.count) == 0) {
+                    otherChunk = &candidate;
+                }
+            }
+
+            if (otherChunk) {
+                ChunkView const otherView(const_cast<Archetype *>(otherArchetype), const_cast<Chunk *>(otherChunk),
+                                          other.tick);
+                func(view, &otherView);
+            }
+            else {
+                func(view, nullptr);
+            }
+        }
+    }
+}
+
+template<typename... Ts, typename Func>
+void World::Each(Func &&func) {
+    this->EachChunk(MaskOf<std::remove_const_t<Ts>...>(), [&func](ChunkView &chunk) {
+        EachRow(chunk, func, chunk.Column<Ts>()...);
+    });
+}
+
+#endif //CUTLASS_WORLD_H
@@ -3,3 +3,16 @@
 //
 
 #include "Camera.h"
+
+glm::mat4 Camera::View() const {
+    // rotation is pitch, yaw, roll in degrees, undone in the reverse order they were applied
+    glm::mat4 view(1.0f);
+    view = glm::rotate(view, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    view = glm::rotate(view, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    view = glm::rotate(view, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    return glm::translate(view, -position);
+}
+
+glm::mat4 Camera::Projection() const {
+    return glm::perspective(glm::radians(fieldOfView), aspect, nearPlane, farPlane);
+}
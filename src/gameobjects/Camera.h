@@ -5,4 +5,20 @@
 #ifndef CUTLASS_CAMERA_H
 #define CUTLASS_CAMERA_H
 
+#include <common.h>
+
+class Camera {
+public:
+    glm::vec3 position;
+    glm::vec3 rotation;
+    // vertical, in degrees
+    float fieldOfView = 75.0f;
+    float aspect = 16.0f / 9.0f;
+    float nearPlane = 1.0f;
+    float farPlane = 8192.0f;
+
+    glm::mat4 View() const;
+    glm::mat4 Projection() const;
+};
+
 #endif //CUTLASS_CAMERA_H
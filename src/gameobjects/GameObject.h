@@ -5,9 +5,43 @@
 #ifndef CUTLASS_GAMEOBJECT_H
 #define CUTLASS_GAMEOBJECT_H
 
+#include "ecs/Entity.h"
+#include "math/Transform.h"
+#include "render/AssetRegistry.h"
+#include "render/Mesh.h"
 
-class GameObject {
+class GameState;
 
+typedef void (*FixedUpdateFunc)(GameState &state, Entity entity, Transform &transform, float time, float deltaTime);
+
+/*
+ * components a game object is split into once it is pushed into a game state. objects without a behaviour are
+ * never visited by the fixed update.
+ */
+struct Renderable {
+    MeshHandle mesh;
+    MaterialHandle material;
+    glm::vec4 tint;
+};
+
+/*
+ * behaviours of different chunks run in parallel. a behaviour may write the transform it's given and spawn or
+ * remove objects through the state, but mustn't touch other entities' components.
+ */
+struct Behaviour {
+    FixedUpdateFunc fixedUpdate;
+};
+
+/*
+ * description of an object to spawn, see GameState::PushObject. the mesh and material are registered on the way in,
+ * or on playback when pushed from a parallel update.
+ */
+class GameObject : public Transform {
+public:
+    Mesh mesh;
+    Material material;
+    glm::vec4 tint = glm::vec4(1.0f);
+    FixedUpdateFunc fixedUpdate = nullptr;
 };
 
 
@@ -3,3 +3,50 @@
 //
 
 #include "Player.h"
+#include "GameState.h"
+
+namespace {
+    // units per second, the hull is sized in the same units
+    const float walkSpeed = 320.0f;
+    const float duckSpeed = 110.0f;
+    // degrees per pixel of mouse movement, and per second while a look key is held
+    const float mouseSensitivity = 0.1f;
+    const float lookSpeed = 120.0f;
+}
+
+void Player::FixedUpdate(GameState &state, [[maybe_unused]] float time, float deltaTime) {
+    bool ducking = (state.buttonFlags & CUT_DUCK) != 0;
+
+    /*
+     * look. the player turns with the yaw, the camera carries the pitch on its own
+     */
+    glm::vec2 look = state.deltaMousePos * mouseSensitivity;
+    if (state.buttonFlags & CUT_LOOK_LEFT) look.x -= lookSpeed * deltaTime;
+    if (state.buttonFlags & CUT_LOOK_RIGHT) look.x += lookSpeed * deltaTime;
+    if (state.buttonFlags & CUT_LOOK_UP) look.y -= lookSpeed * deltaTime;
+    if (state.buttonFlags & CUT_LOOK_DOWN) look.y += lookSpeed * deltaTime;
+
+    rotation = glm::mod(rotation + look.x, 360.0f);
+    camera.rotation.x = glm::clamp(camera.rotation.x + look.y, -89.0f, 89.0f);
+    camera.rotation.y = rotation;
+
+    /*
+     * move on the ground plane, relative to where the player faces. the camera looks down -z at a yaw of 0
+     */
+    float yaw = glm::radians(rotation);
+    glm::vec3 forward(glm::sin(yaw), 0.0f, -glm::cos(yaw));
+    glm::vec3 right(glm::cos(yaw), 0.0f, glm::sin(yaw));
+
+    glm::vec3 wish(0.0f);
+    if (state.buttonFlags & CUT_MOVE_FORWARD) wish += forward;
+    if (state.buttonFlags & CUT_MOVE_BACK) wish -= forward;
+    if (state.buttonFlags & CUT_MOVE_RIGHT) wish += right;
+    if (state.buttonFlags & CUT_MOVE_LEFT) wish -= right;
+
+    // diagonals are no faster than straight lines
+    if (glm::dot(wish, wish) > 0.0f) {
+        position += glm::normalize(wish) * (ducking ? duckSpeed : walkSpeed) * deltaTime;
+    }
+
+    camera.position = position + glm::vec3(0.0f, ducking ? duckEyeHeight : eyeHeight, 0.0f);
+}
@@ -5,4 +5,22 @@
 #ifndef CUTLASS_PLAYER_H
 #define CUTLASS_PLAYER_H
 
+#include <common.h>
+#include "gameobjects/Camera.h"
+
+class GameState;
+
+class Player {
+public:
+    glm::vec3 position;
+    float rotation;
+    glm::vec3 hull;
+    glm::vec3 duckHull;
+    float eyeHeight;
+    float duckEyeHeight;
+    Camera camera;
+
+    void FixedUpdate(GameState &state, float time, float deltaTime);
+};
+
 #endif //CUTLASS_PLAYER_H
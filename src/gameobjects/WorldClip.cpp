@@ -3,3 +3,26 @@
 //
 
 #include "WorldClip.h"
+
+Mesh CreateGenericWorldClip() {
+    /*
+     * a floor at y = 0, wide enough that the edge is never in view. the texture repeats every tile units, the
+     * VAO is left empty so the mesh goes through the shared geometry buffer like any other
+     */
+    const float extent = 4096.0f;
+    const float tile = 128.0f;
+    const float repeat = extent / tile;
+    const glm::vec4 color(1.0f);
+
+    Mesh mesh;
+    mesh.vertices = {
+            {glm::vec3(-extent, 0.0f, -extent), color, glm::vec2(-repeat, repeat)},
+            {glm::vec3(extent, 0.0f, -extent), color, glm::vec2(repeat, repeat)},
+            {glm::vec3(extent, 0.0f, extent), color, glm::vec2(repeat, -repeat)},
+            {glm::vec3(-extent, 0.0f, extent), color, glm::vec2(-repeat, -repeat)},
+    };
+    // counter-clockwise seen from above
+    mesh.indices = {0, 2, 1, 0, 3, 2};
+
+    return mesh;
+}
@@ -5,4 +5,8 @@
 #ifndef CUTLASS_WORLDCLIP_H
 #define CUTLASS_WORLDCLIP_H
 
+#include "render/Mesh.h"
+
+Mesh CreateGenericWorldClip();
+
 #endif //CUTLASS_WORLDCLIP_H
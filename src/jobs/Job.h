@@ -0,0 +1,43 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_JOB_H
+#define CUTLASS_JOB_H
+
+#include <atomic>
+#include <cstdint>
+
+/*
+ * counts the jobs that still have to finish before whatever depends on them can go ahead
+ */
+class JobCounter {
+public:
+    JobCounter() : pending(0) {}
+    JobCounter(JobCounter const &) = delete;
+    JobCounter &operator=(JobCounter const &) = delete;
+
+    bool Done() const { return this->pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending;
+};
+
+/*
+ * a unit of work. jobs don't own anything, so whatever data points at has to outlive the job.
+ */
+struct Job {
+    void (*function)(Job &job);
+    void *data;
+    uint32_t begin;
+    uint32_t end;
+
+    // signalled when the job finishes
+    JobCounter *counter;
+
+    // the job doesn't start until this is done, if set
+    JobCounter *dependency;
+};
+
+#endif //CUTLASS_JOB_H
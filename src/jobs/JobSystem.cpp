@@ -0,0 +1,148 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "JobSystem.h"
+
+#include <algorithm>
+
+// how many times an idle worker looks for work before going to sleep
+#define CUT_JOB_SPIN_COUNT 256
+
+static thread_local JobSystem const *currentSystem = nullptr;
+static thread_local int currentWorker = -1;
+
+JobSystem::JobSystem(int workers) : queued(0), running(true) {
+    if (workers <= 0) {
+        workers = (int) std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (int i = 0; i < workers; ++i) {
+        this->workers.push_back(std::make_unique<Worker>());
+    }
+
+    currentSystem = this;
+    currentWorker = 0;
+
+    for (int i = 1; i < workers; ++i) {
+        this->workers[i]->thread = std::thread(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(this->sleepMutex);
+        this->running.store(false);
+    }
+    this->wake.notify_all();
+
+    for (auto &worker : this->workers) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+
+    if (currentSystem == this) {
+        currentSystem = nullptr;
+        currentWorker = -1;
+    }
+}
+
+void JobSystem::Schedule(Job *jobs, uint32_t count, JobCounter *counter) {
+    counter->pending.fetch_add((int) count, std::memory_order_relaxed);
+
+    int self = this->Self();
+    for (uint32_t i = 0; i < count; ++i) {
+        jobs[i].counter = counter;
+
+        if (self >= 0 && this->workers[self]->deque.Push(&jobs[i])) continue;
+
+        std::lock_guard<std::mutex> lock(this->sharedMutex);
+        this->shared.push_back(&jobs[i]);
+    }
+
+    this->queued.fetch_add((int) count, std::memory_order_release);
+    {
+        // taking the lock makes sure a worker that is about to sleep sees the new jobs
+        std::lock_guard<std::mutex> lock(this->sleepMutex);
+    }
+    this->wake.notify_all();
+}
+
+void JobSystem::Wait(JobCounter *counter) {
+    int self = this->Self();
+    while (!counter->Done()) {
+        if (!this->RunOne(self)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+int JobSystem::Self() const {
+    return currentSystem == this ? currentWorker : -1;
+}
+
+Job *JobSystem::Find(int self) {
+    Job *job = nullptr;
+
+    if (self >= 0) {
+        job = this->workers[self]->deque.Pop();
+    }
+
+    if (!job) {
+        std::lock_guard<std::mutex> lock(this->sharedMutex);
+        if (!this->shared.empty()) {
+            job = this->shared.front();
+            this->shared.pop_front();
+        }
+    }
+
+    // steal, starting from our neighbour so thieves spread out over the pool
+    int count = (int) this->workers.size();
+    for (int i = 1; !job && i <= count; ++i) {
+        int victim = (std::max(self, 0) + i) % count;
+        if (victim == self) continue;
+        job = this->workers[victim]->deque.Steal();
+    }
+
+    if (job) {
+        this->queued.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    return job;
+}
+
+bool JobSystem::RunOne(int self) {
+    Job *job = this->Find(self);
+    if (!job) return false;
+
+    this->Run(job);
+    return true;
+}
+
+void JobSystem::Run(Job *job) {
+    if (job->dependency) {
+        this->Wait(job->dependency);
+    }
+
+    // the counter may be released as soon as it's signalled, so read it first
+    JobCounter *counter = job->counter;
+    job->function(*job);
+    counter->pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::WorkerLoop(int index) {
+    currentSystem = this;
+    currentWorker = index;
+
+    while (this->running.load(std::memory_order_relaxed)) {
+        bool ran = false;
+        for (int spin = 0; spin < CUT_JOB_SPIN_COUNT && !ran; ++spin) {
+            ran = this->RunOne(index);
+        }
+        if (ran) continue;
+
+        std::unique_lock<std::mutex> lock(this->sleepMutex);
+        this->wake.wait(lock, [this] {
+            return this->queued.load(std::memory_order_acquire) > 0 || !this->running.load();
+        });
+    }
+}
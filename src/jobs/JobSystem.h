@@ -0,0 +1,95 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_JOBSYSTEM_H
+#define CUTLASS_JOBSYSTEM_H
+
+#include "jobs/Job.h"
+#include "jobs/WorkDeque.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * work stealing thread pool. every worker has its own deque and steals from the others when it runs dry. the thread
+ * that creates the pool counts as worker 0 and only runs jobs while it waits on a counter. other threads can
+ * schedule and wait too, their jobs go through a shared queue.
+ */
+class JobSystem {
+public:
+    // workers counts the creating thread, 0 means one per hardware thread
+    explicit JobSystem(int workers = 0);
+    ~JobSystem();
+
+    JobSystem(JobSystem const &) = delete;
+    JobSystem &operator=(JobSystem const &) = delete;
+
+    int WorkerCount() const { return (int) this->workers.size(); }
+
+    // jobs has to stay alive until the counter is done
+    void Schedule(Job *jobs, uint32_t count, JobCounter *counter);
+
+    // runs other jobs until the counter is done
+    void Wait(JobCounter *counter);
+
+    /*
+     * calls func(begin, end) over [0, count) in batches of grain. batches don't depend on how many workers there
+     * are, so anything that keys per batch state off begin gets the same result however many threads run it.
+     */
+    template<typename Func>
+    void ParallelFor(uint32_t count, uint32_t grain, Func &&func);
+
+private:
+    struct Worker {
+        WorkDeque deque;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex sharedMutex;
+    std::deque<Job *> shared;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queued;
+    std::atomic<bool> running;
+
+    int Self() const;
+    Job *Find(int self);
+    bool RunOne(int self);
+    void Run(Job *job);
+    void WorkerLoop(int index);
+};
+
+template<typename Func>
+void JobSystem::ParallelFor(uint32_t count, uint32_t grain, Func &&func) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    uint32_t batches = (count + grain - 1) / grain;
+    if (batches == 1) {
+        func(0u, count);
+        return;
+    }
+
+    std::unique_ptr<Job[]> jobs(new Job[batches]);
+    for (uint32_t i = 0; i < batches; ++i) {
+        jobs[i].function = [](Job &job) { (*static_cast<std::remove_reference_t<Func> *>(job.data))(job.begin, job.end); };
+        jobs[i].data = (void *) &func;
+        jobs[i].begin = i * grain;
+        jobs[i].end = std::min(count, (i + 1) * grain);
+        jobs[i].dependency = nullptr;
+    }
+
+    JobCounter counter;
+    this->Schedule(jobs.get(), batches, &counter);
+    this->Wait(&counter);
+}
+
+#endif //CUTLASS_JOBSYSTEM_H
@@ -0,0 +1,79 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_WORKDEQUE_H
+#define CUTLASS_WORKDEQUE_H
+
+#include "jobs/Job.h"
+
+#include <atomic>
+#include <cstdint>
+
+#define CUT_WORK_DEQUE_SIZE 4096
+
+/*
+ * fixed size Chase-Lev deque. the owning worker pushes and pops at the bottom, any other thread can steal from the
+ * top. memory ordering follows Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models".
+ */
+class WorkDeque {
+public:
+    WorkDeque() : top(0), bottom(0) {
+        for (auto &slot : this->slots) slot.store(nullptr, std::memory_order_relaxed);
+    }
+
+    // owner only. false when the deque is full.
+    bool Push(Job *job) {
+        int64_t b = this->bottom.load(std::memory_order_relaxed);
+        int64_t t = this->top.load(std::memory_order_acquire);
+        if (b - t >= CUT_WORK_DEQUE_SIZE) return false;
+
+        this->slots[b & (CUT_WORK_DEQUE_SIZE - 1)].store(job, std::memory_order_relaxed);
+        this->bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    // owner only
+    Job *Pop() {
+        int64_t b = this->bottom.load(std::memory_order_relaxed) - 1;
+        this->bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = this->top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            this->bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job *job = this->slots[b & (CUT_WORK_DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+        if (t == b) {
+            // last job left, race any thieves for it
+            if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                job = nullptr;
+            }
+            this->bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    // any thread
+    Job *Steal() {
+        int64_t t = this->top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = this->bottom.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+
+        Job *job = this->slots[t & (CUT_WORK_DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+        if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return job;
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> top;
+    alignas(64) std::atomic<int64_t> bottom;
+    alignas(64) std::atomic<Job *> slots[CUT_WORK_DEQUE_SIZE];
+};
+
+#endif //CUTLASS_WORKDEQUE_H
@@ -1,11 +1,43 @@
 #include "common.h"
-#include "cutlass.h"
+#include "FramePacer.h"
+#include "GameState.h"
+#include "Input.h"
+#include "InterpolatedState.h"
+#include "Profiler.h"
+#include "RenderSnapshot.h"
+#include "SpatialIndex.h"
+#include "StateBuffer.h"
+#include "TripleBuffer.h"
+#include "gameobjects/WorldClip.h"
+#include "jobs/JobSystem.h"
+#include "math/Frustum.h"
+#include "render/FrameArena.h"
+#include "render/GeometryBuffer.h"
+#include "render/GLCapture.h"
+#ifdef CUT_HEADLESS
+#include "render/HeadlessContext.h"
+#endif
+#include "render/GLState.h"
+#include "render/RenderPacket.h"
+#include "render/RenderQueue.h"
+#include "render/StreamBuffer.h"
+#include "render/UniformBuffers.h"
 #include <stb_image.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
 int width = 1024;
 int height = 576;
 const char gameTitle[8] = "Cutlass";
 constexpr float fixedTimestep(1 / 60.0f);
+constexpr int targetFrameRate = 120;
+constexpr int maxSubsteps = 5;
 std::map<int, ButtonFlags> buttonMap = {
         {GLFW_KEY_ESCAPE,           CUT_ESC},
         {GLFW_KEY_SPACE,            CUT_JUMP},
@@ -22,16 +54,58 @@ std::map<int, ButtonFlags> buttonMap = {
         {GLFW_KEY_DOWN,             CUT_LOOK_DOWN},
 };
 
+/*
+ * input sampled by the main thread, waiting for the simulation thread to pick it up. mouse movement adds up until
+ * it's taken, and so do buttons: a key tapped between two ticks still shows up as pressed for one of them.
+ */
+struct InputMailbox {
+    std::mutex mutex;
+    glm::vec2 mousePos;
+    glm::vec2 deltaMousePos;
+    glm::vec2 deltaScroll;
+    ButtonFlags buttonFlags = CUT_BUTTON_NONE;
+    ButtonFlags pressedFlags = CUT_BUTTON_NONE;
+};
+
 GLFWwindow *window;
-GameState currentState;
-GameState previousState;
+JobSystem jobs;
+StateBuffer states;
+SpatialIndex spatialIndex;
+InterpolatedState interpolatedState;
+FrameArena frameArena;
+RenderQueue renderQueue;
+StreamBuffer streamBuffer;
+UniformBuffers uniformBuffers;
+InstanceBuffer instanceBuffer;
+GeometryBuffer geometryBuffer(BasicVertexFormat());
+InputMailbox input;
+TripleBuffer<RenderSnapshot> snapshots;
+std::atomic<bool> simulating(true);
+int simulationError = CUT_NO_ERROR;
+glm::vec2 mousePos;
 glm::vec2 deltaScroll;
+ButtonFlags buttonFlags = CUT_BUTTON_NONE;
 bool mouseSet = false;
 bool mouseLocked = false;
 bool mouseLockReady = false;
+std::vector<ChunkView> updateChunks;
+std::vector<CommandBuffer> updateCommands;
 
 void KeyCallback(GLFWwindow *window, int key, int scancode, int action, int mods) {
     std::cout << "key: " << key << std::endl;
+
+    /*
+     * F3 turns the profiler on and off, F4 prints what it has and writes a trace for chrome://tracing
+     */
+    if (action != GLFW_PRESS) return;
+    if (key == GLFW_KEY_F3) {
+        profiler.SetEnabled(!profiler.Enabled());
+        if (!profiler.Enabled()) glfwSetWindowTitle(window, gameTitle);
+    }
+    else if (key == GLFW_KEY_F4 && profiler.Enabled()) {
+        profiler.PrintSummary();
+        if (profiler.WriteTrace("cutlass.trace.json")) std::cout << "Wrote the profile to cutlass.trace.json" << std::endl;
+    }
 }
 
 void MouseCallback(GLFWwindow *window, double xpos, double ypos) {
@@ -51,10 +125,12 @@ void ScrollCallback(GLFWwindow *window, double xpos, double ypos) {
 void FramebufferSizeCallback(GLFWwindow *window, int width, int height) {
     // fix for an issue on mac OS where resizing the window doesnt automatically
     // update our viewport.
-    glViewport(0, 0, width, height);
+    glState.SetViewport(0, 0, width, height);
 }
 
 void UpdateInput() {
+    CUT_PROFILE("UpdateInput");
+
     /*
      * mouse update
      */
@@ -62,31 +138,20 @@ void UpdateInput() {
     glfwGetCursorPos(window, &mouseX, &mouseY);
 
     if (!mouseSet) {
-        currentState.mousePos = glm::vec2((float) mouseX, (float) mouseY);
+        mousePos = glm::vec2((float) mouseX, (float) mouseY);
         mouseSet = true;
     }
 
-    currentState.deltaMousePos = glm::vec2(mouseX - currentState.mousePos.x, mouseY - currentState.mousePos.y);
-    currentState.mousePos = glm::vec2((float) mouseX, (float) mouseY);
-    currentState.deltaScroll = deltaScroll;
+    glm::vec2 deltaMousePos = glm::vec2(mouseX - mousePos.x, mouseY - mousePos.y);
+    mousePos = glm::vec2((float) mouseX, (float) mouseY);
 
     /*
      * keyboad update
      */
-    // start with no buttons pressed/cleared flags
-    ButtonFlags buttonFlags = CUT_BUTTON_NONE;
-    for (auto const&[key, val] : buttonMap) {
-        if (glfwGetKey(window, key) == GLFW_PRESS) {
-            buttonFlags |= val;
-        }
-    }
+    buttonFlags = ScanButtons(window, buttonMap);
 
-    currentState.oldButtonFlags = currentState.buttonFlags;
-    currentState.buttonFlags = buttonFlags;
-}
-
-void Update(float time, float deltaTime) {
-    if (currentState.buttonFlags & CUT_ESC) {
+    // the cursor belongs to the window, so locking it happens here rather than in the simulation
+    if (buttonFlags & CUT_ESC) {
         if (mouseLockReady) {
             if (mouseLocked) {
                 glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
@@ -103,78 +168,350 @@ void Update(float time, float deltaTime) {
         mouseLockReady = true;
     }
 
-    currentState.player.FixedUpdate(currentState, time, deltaTime);
+    std::lock_guard<std::mutex> lock(input.mutex);
+    input.mousePos = mousePos;
+    input.deltaMousePos += deltaMousePos;
+    input.deltaScroll = deltaScroll;
+    input.buttonFlags = buttonFlags;
+    input.pressedFlags |= buttonFlags;
+}
 
-    for (auto it = currentState.objects.begin(); it != currentState.objects.end(); ++it) {
-        it->second.FixedUpdate(currentState, time, deltaTime);
-    }
+/*
+ * called by the simulation thread before the first tick of a frame
+ */
+void ConsumeInput(GameState &state) {
+    std::lock_guard<std::mutex> lock(input.mutex);
+
+    state.mousePos = input.mousePos;
+    state.deltaMousePos = input.deltaMousePos;
+    state.deltaScroll = input.deltaScroll;
+    state.oldButtonFlags = state.buttonFlags;
+    state.buttonFlags = input.buttonFlags | input.pressedFlags;
+
+    input.deltaMousePos = glm::vec2(0.0f, 0.0f);
+    input.pressedFlags = CUT_BUTTON_NONE;
 }
 
-GameState InterpolateState(GameState const &current, GameState const &previous, double alpha) {
+void Update(float time, float deltaTime) {
+    CUT_PROFILE("Update");
+
+    GameState &currentState = states.Current();
+
+    currentState.player.FixedUpdate(currentState, time, deltaTime);
 
     /*
-     * state interpolation is implementation specific, so this boiler plate doesn't do much other than interpolate
-     * entities and the camera
+     * behaviours run in parallel, a chunk per job. each chunk records its spawns and despawns into its own buffer and
+     * the buffers are played back in chunk order, so the outcome doesn't depend on how many threads ran the update.
      */
+    updateChunks.clear();
+    currentState.world.EachChunk(MaskOf<Transform, Behaviour>(), [&](ChunkView &chunk) {
+        updateChunks.push_back(chunk);
+    });
+    if (updateCommands.size() < updateChunks.size()) updateCommands.resize(updateChunks.size());
+
+    jobs.ParallelFor((uint32_t) updateChunks.size(), 1, [&](uint32_t begin, uint32_t end) {
+        CUT_PROFILE("UpdateChunks");
+        for (uint32_t c = begin; c < end; ++c) {
+            ChunkView &chunk = updateChunks[c];
+            GameState::jobCommands = &updateCommands[c];
+
+            Entity const *entities = chunk.Entities();
+            Transform const *transforms = chunk.Read<Transform>();
+            Behaviour const *behaviours = chunk.Read<Behaviour>();
+            Transform *written = nullptr;
+
+            for (uint32_t i = 0; i < chunk.Count(); ++i) {
+                Transform transform = transforms[i];
+                behaviours[i].fixedUpdate(currentState, entities[i], transform, time, deltaTime);
+
+                // only chunks where something actually moved get copied forward on the next buffer swap
+                if (transform != transforms[i]) {
+                    // built here, so whatever stops moving reaches the renderer with its matrix ready
+                    transform.Model();
+                    if (!written) written = chunk.Write<Transform>();
+                    written[i] = transform;
+                }
+            }
+        }
+        GameState::jobCommands = nullptr;
+    });
+
+    // spawns and despawns requested during the tick
+    currentState.FlushCommands();
+    for (size_t c = 0; c < updateChunks.size(); ++c) {
+        updateCommands[c].Playback(currentState.world);
+    }
+
+    // ready for the next tick's behaviours, with everything that moved or spawned in this one
+    spatialIndex.Update(currentState.world);
+}
+
+void ExtractSnapshot(RenderSnapshot &snapshot, GameState const &current, GameState const &previous) {
+    CUT_PROFILE("ExtractSnapshot");
 
-    GameState integratedState(previous);
+    snapshot.Clear();
+    snapshot.previousPlayer = previous.player;
+    snapshot.player = current.player;
 
-    for (auto it = integratedState.objects.begin(); it != integratedState.objects.end(); ++it)
-    {
-        // we only interpolate if our new state contains the same entity.
-        // the map's key acts as a UID for the entity.
-        if (current.objects.count(it->first))
-        {
-            // interpolate the iterated ent towards the current ent
-            auto currentEnt = current.objects.at(it->first);
-            auto ent = it->second;
+    current.world.EachChunkPair(previous.world, MaskOf<Transform, Renderable>(), [&](ChunkView const &chunk, ChunkView const *previousChunk) {
+        uint32_t begin = (uint32_t) snapshot.entities.size();
+        uint32_t count = chunk.Count();
 
-            ent.worldPosition = glm::mix(ent.worldPosition, currentEnt.worldPosition, alpha);
-            ent.localScale = glm::mix(ent.localScale, currentEnt.localScale, alpha);
-            ent.localRotation = glm::mix(ent.localRotation, currentEnt.localRotation, alpha);
+        Entity const *entities = chunk.Entities();
+        Transform const *transforms = chunk.Read<Transform>();
+        Renderable const *renderables = chunk.Read<Renderable>();
 
-            it->second = ent;
+        snapshot.entities.insert(snapshot.entities.end(), entities, entities + count);
+        snapshot.transforms.insert(snapshot.transforms.end(), transforms, transforms + count);
+        snapshot.renderables.insert(snapshot.renderables.end(), renderables, renderables + count);
+        snapshot.previousTransforms.resize(begin + count);
+
+        // nothing in this chunk moved during the last tick, so both states already agree
+        bool moved = !previousChunk || chunk.Version<Transform>() == current.world.Tick();
+        snapshot.ranges.push_back({begin, count, moved});
+        if (!moved) return;
+
+        Transform *previousTransforms = snapshot.previousTransforms.data() + begin;
+
+        // the chunk holds the same entities in both states, so the old column can be copied as is
+        if (previousChunk) {
+            std::copy(previousChunk->Read<Transform>(), previousChunk->Read<Transform>() + count, previousTransforms);
+            return;
+        }
+
+        // something was spawned or despawned here last tick. entities that are new this tick aren't interpolated.
+        for (uint32_t i = 0; i < count; ++i) {
+            if (previous.world.Has<Transform>(entities[i])) {
+                previousTransforms[i] = previous.world.Get<Transform>(entities[i]);
+            }
+            else {
+                previousTransforms[i] = transforms[i];
+            }
+        }
+    });
+}
+
+/*
+ * the snapshot entities that are at least partly inside the frustum, as ascending indices allocated out of the frame
+ * arena. entities that moved are tested against a box that holds for any alpha, so they're culled before anything
+ * is interpolated.
+ */
+uint32_t *CullSnapshot(FrameArena &arena, RenderSnapshot const &snapshot, Frustum const &frustum, size_t &count) {
+    CUT_PROFILE("CullSnapshot");
+
+    size_t total = snapshot.renderables.size();
+    float *bounds = arena.Allocate<float>(total * 6);
+    float *center[3] = {bounds, bounds + total, bounds + total * 2};
+    float *extents[3] = {bounds + total * 3, bounds + total * 4, bounds + total * 5};
+
+    for (SnapshotRange const &range : snapshot.ranges) {
+        for (uint32_t i = range.begin; i < range.begin + range.count; ++i) {
+            glm::vec3 c, e;
+            SnapshotBounds(snapshot, range, i, c, e);
+            for (int axis = 0; axis < 3; ++axis) {
+                center[axis][i] = c[axis];
+                extents[axis][i] = e[axis];
+            }
         }
     }
 
-    /*
-     * interpolate player
-     */
-    auto player = integratedState.player;
-    if (player.position != previous.player.position) player.position = glm::mix(player.position, previousState.player.position, alpha);
-    if (player.rotation != previous.player.rotation) player.rotation = glm::mix(player.rotation, previousState.player.rotation, alpha);
-    integratedState.player = player;
+    uint32_t *visible = arena.Allocate<uint32_t>(total);
+    count = CullBoxes(frustum, {{center[0], center[1], center[2]}, {extents[0], extents[1], extents[2]}}, total, visible);
+    return visible;
+}
 
-    /*
-     * interpolate player's camera
-     */
-    auto camera = integratedState.player.camera;
-    if (camera.position != previous.player.camera.position) camera.position = glm::mix(camera.position, previous.player.camera.position, alpha);
-    if (camera.rotation != previous.player.camera.rotation) camera.rotation = glm::mix(camera.position, previous.player.camera.rotation, alpha);
-    integratedState.player.camera = camera;
+/*
+ * flattens the visible entities into one packet per draw, allocated out of the frame arena. only these get
+ * interpolated.
+ */
+RenderPacket *ExtractPackets(FrameArena &arena, RenderSnapshot const &snapshot, InterpolatedState &interpolated, uint32_t const *visible,
+                             size_t count, float alpha, glm::mat4 const &view) {
+    CUT_PROFILE("ExtractPackets");
+
+    RenderPacket *packets = arena.Allocate<RenderPacket>(count);
+    InterpolateModels(&packets->model, sizeof(RenderPacket), interpolated, snapshot, visible, count, alpha);
+
+    for (size_t i = 0; i < count; ++i) {
+        Renderable const &renderable = snapshot.renderables[visible[i]];
+        packets[i].mesh = renderable.mesh;
+        packets[i].material = renderable.material;
+        packets[i].tint = renderable.tint;
+
+        // the camera looks down -z
+        float depth = -(view * packets[i].model[3]).z;
+        packets[i].sortKey = MakeSortKey(renderable.mesh, renderable.material, depth);
+    }
 
-    return integratedState;
+    return packets;
 }
 
-void Render(GameState renderState) {
+void Render(RenderQueue &queue, FrameUniforms const &frame) {
+    CUT_PROFILE("Render");
+    CUT_PROFILE_GPU("Render");
+
+    // the depth mask has to be on for the clear to reach the depth buffer
+    glState.SetDepth(true, true);
     glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    const glm::mat4 view = renderState.player.camera.View();
-    const glm::mat4 projection = renderState.player.camera.Projection();
+    // camera data goes up once for the whole frame, every program reads it from the same block
+    streamBuffer.BeginFrame();
+    if (uniformBuffers.UploadFrame(frame)) {
+        queue.Submit(frameArena, streamBuffer, uniformBuffers, instanceBuffer, geometryBuffer);
+    }
+    streamBuffer.EndFrame();
+}
+
+/*
+ * everything the render thread does with a snapshot, short of presenting it
+ */
+void DrawFrame(RenderSnapshot const &snapshot, float alpha, float time, float deltaTime) {
+    CUT_PROFILE("DrawFrame");
+
+    glState.BeginFrame();
+
+    InterpolateState(interpolatedState, snapshot, alpha);
+
+    Camera const &camera = interpolatedState.player.camera;
+    glm::mat4 view = camera.View();
+
+    FrameUniforms frame;
+    frame.view = view;
+    frame.projection = camera.Projection();
+    frame.viewProjection = frame.projection * frame.view;
+    frame.time = glm::vec4(time, deltaTime, 0.0f, 0.0f);
+
+    frameArena.Reset();
+    size_t packetCount;
+    uint32_t *visible = CullSnapshot(frameArena, snapshot, Frustum(frame.viewProjection), packetCount);
+    RenderPacket *packets = ExtractPackets(frameArena, snapshot, interpolatedState, visible, packetCount, alpha, view);
+    renderQueue.Sort(frameArena, packets, packetCount);
+
+    Render(renderQueue, frame);
+}
+
+/*
+ * the simulation thread. ticks at the fixed rate on its own and publishes a snapshot after every frame that ticked,
+ * while the main thread keeps drawing whatever snapshot is newest.
+ */
+void Simulate() {
+    profiler.SetThreadName("simulation");
+
+    try {
+        // 1 / (1 / 60.0f) is a hair under 60, truncating it would pace the loop at 59
+        FramePacer pacer(SecondsToTicks(fixedTimestep), (int) std::lround(1.0 / fixedTimestep), maxSubsteps);
+
+        // falling behind tends to last a while, so it's reported at most once a second rather than every frame
+        Ticks const reportInterval = SecondsToTicks(1.0);
+        Ticks lastReport = ClockNow();
 
-    for (auto it = renderState.objects.begin(); it != renderState.objects.end(); ++it) {
-        auto obj = it->second;
-        RenderMesh(&obj.mesh, &obj.material, obj.LocalTransform(), obj.WorldTransform(), view, projection);
+        while (simulating.load(std::memory_order_relaxed)) {
+            pacer.BeginFrame();
+
+            bool ticked = false;
+            while (pacer.Step()) {
+                if (!ticked) ConsumeInput(states.Current());
+                ticked = true;
+
+                // swaps previous/current and catches the new current state up with the last tick
+                states.Advance();
+                Update((float) TicksToSeconds(pacer.SimulationTime()), fixedTimestep);
+                states.Current().deltaMousePos = glm::vec2(0.0f, 0.0f);
+            }
+
+            if (ticked) {
+                RenderSnapshot &snapshot = snapshots.Back();
+                ExtractSnapshot(snapshot, states.Current(), states.Previous());
+                snapshot.fixedStep = SecondsToTicks(fixedTimestep);
+                snapshot.remainder = pacer.Remainder();
+                snapshot.published = ClockNow();
+                snapshots.Publish();
+            }
+
+            // sleeps, then spins, until the next tick is due
+            pacer.EndFrame();
+
+            Ticks now = ClockNow();
+            if (now - lastReport >= reportInterval) {
+                FrameReport totals = pacer.TakeTotals();
+                if (totals.dropped) {
+                    std::cout << "Simulation fell " << TicksToMilliseconds(totals.dropped) << "ms behind over the last "
+                              << totals.frames << " frames, slowing down" << std::endl;
+                }
+                lastReport = now;
+            }
+        }
+    }
+    catch (Error error) {
+        std::cout << "There was a Cutlass Error on the simulation thread (" << error << ")" << std::endl;
+        simulationError = error;
+        glfwSetWindowShouldClose(window, GLFW_TRUE);
     }
+}
 
-    glfwSwapBuffers(window);
-    glfwPollEvents();
+void InitRenderer() {
+    glState.SetDepth(true, true);
+    streamBuffer.Init();
+    uniformBuffers.Init(streamBuffer);
+    instanceBuffer.Init(streamBuffer);
+    geometryBuffer.Init();
+    profiler.InitGPU();
+
+    std::cout << "GL VENDOR = " << glGetString(GL_VENDOR) << std::endl;
+    std::cout << "GL RENDERER = " << glGetString(GL_RENDERER) << std::endl;
+    std::cout << "GL VERSION = " << glGetString(GL_VERSION) << std::endl;
 }
 
-int main() {
+void LoadScene() {
+    CUT_PROFILE("LoadScene");
+
+    GameState &currentState = states.Current();
 
+    // some asset stuff
+    stbi_set_flip_vertically_on_load(true);
+    Texture container;
+    Texture awesomeface;
+
+    LoadTexture(&container, "assets/container.jpg", GL_RGB, GL_REPEAT, GL_NEAREST);
+    LoadTexture(&awesomeface, "assets/awesomeface.png", GL_RGBA, GL_REPEAT, GL_NEAREST);
+
+    auto basicShader = Shader("shader/basic.vertex.glsl", "shader/basic.fragment.glsl");
+    basicShader.SetInt("u_texture", 0);
+    basicShader.SetInt("u_texture1", 1);
+
+    auto instancedShader = Shader("shader/basic.instanced.vertex.glsl", "shader/basic.fragment.glsl");
+    instancedShader.SetInt("u_texture", 0);
+    instancedShader.SetInt("u_texture1", 1);
+
+    /*
+     * default world clip
+     */
+    auto worldClip = CreateGenericWorldClip();
+    GameObject clip;
+    clip.mesh = worldClip;
+    clip.material.texture[0] = container;
+    clip.material.texture[1] = awesomeface;
+    clip.material.shader = basicShader;
+    clip.material.instancedShader = instancedShader;
+    currentState.PushObject(clip);
+
+    currentState.player.position = glm::vec3(0.0f, 0.0f, 0.0f);
+    currentState.player.rotation = 0.0f;
+    currentState.player.hull = glm::vec3(49.0f, 83.0f, 49.0f);
+    currentState.player.duckHull = glm::vec3(49.0f, 69.0f, 49.0f);
+    currentState.player.eyeHeight = 65.0f;
+    currentState.player.duckEyeHeight = 51.0f;
+
+    currentState.player.camera.rotation.x = 15.0f;
+
+    states.Reset();
+    spatialIndex.Rebuild(states.Current().world);
+    GameState::spatialIndex = &spatialIndex;
+}
+
+int RunWindowed() {
     int result = CUT_NO_ERROR;
+    std::thread simulation;
     try {
         glfwInit();
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -207,75 +544,288 @@ int main() {
         glfwSetKeyCallback(window, KeyCallback);
 
         FramebufferSizeCallback(window, width, height);
-        glEnable(GL_DEPTH_TEST);
+        InitRenderer();
+        LoadScene();
+
+        // finally our game loops begins! the simulation gets a thread of its own, this one keeps input and drawing
+        ExtractSnapshot(snapshots.Back(), states.Current(), states.Previous());
+        snapshots.Publish();
+
+        simulation = std::thread(Simulate);
+        FramePacer pacer(0, targetFrameRate, 1);
+        Ticks startTime = ClockNow();
+        Ticks titleTime = startTime;
 
-        std::cout << "GL VENDOR = " << glGetString(GL_VENDOR) << std::endl;
-        std::cout << "GL RENDERER = " << glGetString(GL_RENDERER) << std::endl;
-        std::cout << "GL VERSION = " << glGetString(GL_VERSION) << std::endl;
+        while (!glfwWindowShouldClose(window)) {
+            pacer.BeginFrame();
+            profiler.BeginFrame();
 
-        // some asset stuff
-        stbi_set_flip_vertically_on_load(true);
-        Texture container;
-        Texture awesomeface;
+            UpdateInput();
 
-        LoadTexture(&container, "assets/container.jpg", GL_RGB, GL_REPEAT, GL_NEAREST);
-        LoadTexture(&awesomeface, "assets/awesomeface.png", GL_RGBA, GL_REPEAT, GL_NEAREST);
+            // picks up the newest snapshot, if the simulation published one since the last frame
+            snapshots.Update();
+            RenderSnapshot const &snapshot = snapshots.Front();
 
-        auto basicShader = Shader("shader/basic.vertex.glsl", "shader/basic.fragment.glsl");
-        basicShader.SetInt("u_texture", 0);
-        basicShader.SetInt("u_texture1", 1);
+            DrawFrame(snapshot, snapshot.Alpha(ClockNow()), (float) TicksToSeconds(ClockNow() - startTime), (float) TicksToSeconds(pacer.Report().frame));
 
-        /*
-         * default world clip
-         */
-        auto worldClip = CreateGenericWorldClip();
-        GameObject clip;
-        clip.mesh = worldClip;
-        clip.material.texture[0] = container;
-        clip.material.texture[1] = awesomeface;
-        clip.material.shader = basicShader;
-        currentState.PushObject(clip);
-
-        currentState.player.position = glm::vec3(0.0f, 0.0f, 0.0f);
-        currentState.player.rotation = 0.0f;
-        currentState.player.hull = glm::vec3(49.0f, 83.0f, 49.0f);
-        currentState.player.duckHull = glm::vec3(49.0f, 69.0f, 49.0f);
-        currentState.player.eyeHeight = 65.0f;
-        currentState.player.duckEyeHeight = 51.0f;
-
-        currentState.player.camera.rotation.x = 15.0f;
-
-        // finally our game loops begins!
-        float accumulator = 0.0f;
-        float currentTime = glfwGetTime();
+            glfwSwapBuffers(window);
+            glfwPollEvents();
 
-        while (!glfwWindowShouldClose(window)) {
-            float deltaTime = glfwGetTime() - currentTime;
-            currentTime = glfwGetTime();
-            accumulator += deltaTime;
+            // the rolling summary goes in the title, a couple of times a second so it can be read
+            profiler.EndFrame();
+            if (profiler.Enabled() && ClockNow() - titleTime > CUT_TICKS_PER_SECOND / 2) {
+                glfwSetWindowTitle(window, (std::string(gameTitle) + " | " + profiler.Summary()).c_str());
+                titleTime = ClockNow();
+            }
 
-            UpdateInput();
+            // sleeps, then spins, until it's time for the next frame
+            pacer.EndFrame();
+        }
+    }
+    catch (Error error) {
+        std::cout << "There was a Cutlass Error (" << error << ")" << std::endl;
+        result = error;
+    }
+
+    simulating = false;
+    if (simulation.joinable()) simulation.join();
+    if (simulationError != CUT_NO_ERROR) result = simulationError;
+
+    glfwTerminate();
+    return result;
+}
+
+struct HeadlessOptions {
+    int frames = 600;
+    const char *dumpPath = nullptr;
+    const char *capturePath = nullptr;
+    const char *replayPath = nullptr;
+    const char *profilePath = nullptr;
+};
+
+void ReportFrameTimes(std::vector<double> const &frameTimes, double total) {
+    std::vector<double> sorted = frameTimes;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double p) { return sorted[(size_t) (p * (sorted.size() - 1))]; };
+
+    std::cout << "Rendered " << frameTimes.size() << " frames at " << width << "x" << height << " in " << total << "ms" << std::endl;
+    std::cout << "Frame ms: min " << sorted.front() << ", median " << percentile(0.5) << ", mean " << total / frameTimes.size()
+              << ", p95 " << percentile(0.95) << ", p99 " << percentile(0.99) << ", max " << sorted.back() << std::endl;
+}
 
-            while (accumulator > fixedTimestep) {
-                accumulator -= fixedTimestep;
+void ReportCapture(GLCapture const &capture) {
+    std::vector<GLCaptureStats> const &frames = capture.Frames();
+    GLCaptureStats const &last = frames.back();
+
+    // the counts only depend on the scene, so every frame of a still scene should match the last one
+    size_t differing = 0;
+    for (GLCaptureStats const &frame : frames) {
+        if (frame.calls != last.calls || frame.draws != last.draws || frame.bytesUploaded != last.bytesUploaded) ++differing;
+    }
+
+    GLCaptureData const &data = capture.Data();
+    std::cout << "Captured " << frames.size() << " frames, " << data.stream.size() / 1024 << "KiB of calls and "
+              << data.blob.size() / 1024 << "KiB of payloads" << std::endl;
+    std::cout << "GL per frame: " << last.calls << " calls, " << last.draws << " draws (" << last.indirectDraws << " indirect), "
+              << last.binds << " binds, " << last.stateChanges << " state changes, " << last.uniformUploads << " uniform uploads, "
+              << last.bufferUploads << " buffer uploads, " << last.bytesUploaded << " bytes uploaded" << std::endl;
+    if (differing) std::cout << differing << " frames had different counts from the last one" << std::endl;
+}
+
+#ifdef CUT_HEADLESS
+void DumpFrame(HeadlessContext const &context, const char *path) {
+    std::vector<unsigned char> pixels = ReadHeadlessFrame(context);
+    if (!WritePPM(path, pixels.data(), context.width, context.height)) {
+        std::cout << "Failed to write " << path << std::endl;
+        throw CUT_ERROR_NO_FILE;
+    }
+    std::cout << "Wrote the final frame to " << path << std::endl;
+}
+
+/*
+ * renders a fixed number of frames into an offscreen framebuffer as fast as it can, then reports how long they
+ * took. the simulation runs one tick per frame on this thread, so every run draws exactly the same frames.
+ */
+int RunHeadless(HeadlessOptions const &options) {
+    int result = CUT_NO_ERROR;
+    HeadlessContext context;
+    try {
+        CreateHeadlessContext(context, width, height);
+        if (options.profilePath) profiler.SetEnabled(true);
+
+        // before anything is created, so the capture has every object the frames use
+        if (options.capturePath) glCapture.Install();
+
+        InitRenderer();
+        LoadScene();
+
+        RenderSnapshot snapshot;
+        std::vector<double> frameTimes((size_t) options.frames);
+        Ticks runStart = ClockNow();
+
+        for (int frame = 0; frame < options.frames; ++frame) {
+            Ticks frameStart = ClockNow();
+            // before the tick, so its Update scopes land in this frame rather than the last one
+            profiler.BeginFrame();
+
+            ConsumeInput(states.Current());
+            states.Advance();
+            Update((float) (frame + 1) * fixedTimestep, fixedTimestep);
+            ExtractSnapshot(snapshot, states.Current(), states.Previous());
+
+            if (glCapture.Installed()) glCapture.BeginFrame();
+            DrawFrame(snapshot, 1.0f, (float) (frame + 1) * fixedTimestep, fixedTimestep);
+            if (glCapture.Installed()) glCapture.EndFrame();
+
+            // wait for the GPU, so the frame time covers all of the frame's work and not just submitting it
+            glFinish();
+            profiler.EndFrame();
+            frameTimes[frame] = TicksToMilliseconds(ClockNow() - frameStart);
+        }
+
+        double total = TicksToMilliseconds(ClockNow() - runStart);
+
+        if (options.frames > 0) {
+            ReportFrameTimes(frameTimes, total);
+
+            RenderQueueStats const &queue = renderQueue.Stats();
+            std::cout << "Last frame: " << queue.packets << " packets, " << queue.draws << " draws, "
+                      << glState.Stats().elided << "/" << glState.Stats().calls << " state calls elided" << std::endl;
+        }
 
-                previousState = currentState;
-                Update(currentTime, fixedTimestep);
+        if (options.capturePath) {
+            glCapture.Uninstall();
+            if (options.frames > 0) ReportCapture(glCapture);
+
+            if (!glCapture.Data().Save(options.capturePath)) {
+                std::cout << "Failed to write " << options.capturePath << std::endl;
+                throw CUT_ERROR_NO_FILE;
+            }
+            std::cout << "Wrote the capture to " << options.capturePath << std::endl;
+        }
+
+        if (options.profilePath) {
+            profiler.PrintSummary();
+            if (!profiler.WriteTrace(options.profilePath)) {
+                std::cout << "Failed to write " << options.profilePath << std::endl;
+                throw CUT_ERROR_NO_FILE;
             }
+            std::cout << "Wrote the profile to " << options.profilePath << std::endl;
+        }
+
+        if (options.dumpPath) DumpFrame(context, options.dumpPath);
+    }
+    catch (Error error) {
+        std::cout << "There was a Cutlass Error (" << error << ")" << std::endl;
+        result = error;
+    }
+
+    DestroyHeadlessContext(context);
+    return result;
+}
 
-            float alpha = accumulator / fixedTimestep;
-            GameState renderState = InterpolateState(currentState, previousState, alpha);
+/*
+ * plays a capture made with --capture back, looping over its frames until it has drawn the number asked for. the
+ * engine doesn't run at all, so this times only what the frames asked of GL.
+ */
+int RunReplay(HeadlessOptions const &options) {
+    int result = CUT_NO_ERROR;
+    HeadlessContext context;
+    try {
+        CreateHeadlessContext(context, width, height);
 
-            currentState.deltaMousePos = glm::vec2(0.0f, 0.0f);
+        GLReplay replay;
+        if (!replay.Load(options.replayPath)) {
+            std::cout << "Failed to read the capture " << options.replayPath << std::endl;
+            throw CUT_ERROR_NO_FILE;
+        }
+        if (!replay.FrameCount()) {
+            std::cout << options.replayPath << " has no frames" << std::endl;
+            throw CUT_ERROR_NO_FILE;
+        }
 
-            Render(renderState);
+        replay.defaultFramebuffer = context.framebuffer;
+        replay.Setup();
+        glFinish();
+
+        std::vector<double> frameTimes((size_t) options.frames);
+        Ticks runStart = ClockNow();
+
+        for (int frame = 0; frame < options.frames; ++frame) {
+            Ticks frameStart = ClockNow();
+            replay.ReplayFrame((size_t) frame % replay.FrameCount());
+            glFinish();
+            frameTimes[frame] = TicksToMilliseconds(ClockNow() - frameStart);
         }
+
+        if (options.frames > 0) ReportFrameTimes(frameTimes, TicksToMilliseconds(ClockNow() - runStart));
+        if (replay.UnknownNames()) std::cout << replay.UnknownNames() << " names in the capture were never created by it" << std::endl;
+
+        if (options.dumpPath) DumpFrame(context, options.dumpPath);
     }
-    catch (int error) {
+    catch (Error error) {
         std::cout << "There was a Cutlass Error (" << error << ")" << std::endl;
         result = error;
     }
 
-    glfwTerminate();
+    DestroyHeadlessContext(context);
     return result;
-}
\ No newline at end of file
+}
+#endif
+
+int main(int argc, char **argv) {
+    profiler.SetThreadName("main");
+
+    /*
+     * --headless [--frames N] [--size WxH] [--dump final.ppm] renders offscreen, e.g. on machines without a GPU or
+     * display. --capture frames.cap records every GL call the headless frames make, --replay frames.cap plays them
+     * back instead of running the game, and --profile trace.json writes where the headless frames' time went.
+     * anything else opens the game window as usual.
+     */
+    bool headless = false;
+    HeadlessOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--headless") {
+            headless = true;
+        }
+        else if (arg == "--frames" && hasValue) {
+            options.frames = std::max(std::atoi(argv[++i]), 0);
+        }
+        else if (arg == "--size" && hasValue) {
+            std::sscanf(argv[++i], "%dx%d", &width, &height);
+        }
+        else if (arg == "--dump" && hasValue) {
+            options.dumpPath = argv[++i];
+        }
+        else if (arg == "--capture" && hasValue) {
+            headless = true;
+            options.capturePath = argv[++i];
+        }
+        else if (arg == "--profile" && hasValue) {
+            headless = true;
+            options.profilePath = argv[++i];
+        }
+        else if (arg == "--replay" && hasValue) {
+            headless = true;
+            options.replayPath = argv[++i];
+        }
+        else {
+            std::cout << "Unknown argument: " << arg << std::endl;
+        }
+    }
+
+#ifdef CUT_HEADLESS
+    if (options.replayPath) return RunReplay(options);
+    return headless ? RunHeadless(options) : RunWindowed();
+#else
+    if (headless) {
+        std::cout << "This build has no headless mode, it needs EGL" << std::endl;
+        return CUT_ERROR_NO_HEADLESS;
+    }
+    return RunWindowed();
+#endif
+}
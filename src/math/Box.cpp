@@ -3,3 +3,30 @@
 //
 
 #include "Box.h"
+
+void Box::Expand(glm::vec3 const &point) {
+    this->min = glm::min(this->min, point);
+    this->max = glm::max(this->max, point);
+}
+
+void Box::Expand(Box const &other) {
+    this->min = glm::min(this->min, other.min);
+    this->max = glm::max(this->max, other.max);
+}
+
+bool Box::Contains(glm::vec3 const &point) const {
+    return glm::all(glm::greaterThanEqual(point, this->min)) && glm::all(glm::lessThanEqual(point, this->max));
+}
+
+bool Box::Overlaps(Box const &other) const {
+    return glm::all(glm::lessThanEqual(this->min, other.max)) && glm::all(glm::lessThanEqual(other.min, this->max));
+}
+
+Box Box::Transformed(glm::mat4 const &matrix) const {
+    if (this->Empty()) return *this;
+
+    glm::vec3 center = this->Center();
+    glm::vec3 extents = this->Extents();
+    TransformBox(center, extents, matrix);
+    return Box(center - extents, center + extents);
+}
@@ -5,4 +5,43 @@
 #ifndef CUTLASS_BOX_H
 #define CUTLASS_BOX_H
 
+#include <common.h>
+
+#include <limits>
+
+/*
+ * axis aligned bounding box. a box with min above max is empty, that's what a default box is.
+ */
+struct Box {
+    glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 max = glm::vec3(-std::numeric_limits<float>::max());
+
+    Box() = default;
+    Box(glm::vec3 const &min, glm::vec3 const &max) : min(min), max(max) {}
+
+    bool Empty() const { return this->min.x > this->max.x || this->min.y > this->max.y || this->min.z > this->max.z; }
+    glm::vec3 Center() const { return (this->min + this->max) * 0.5f; }
+    // half the size
+    glm::vec3 Extents() const { return (this->max - this->min) * 0.5f; }
+
+    void Expand(glm::vec3 const &point);
+    void Expand(Box const &other);
+
+    bool Contains(glm::vec3 const &point) const;
+    bool Overlaps(Box const &other) const;
+
+    // the box around this one once it's been put through matrix, which may rotate, scale and translate it
+    Box Transformed(glm::mat4 const &matrix) const;
+};
+
+/*
+ * Arvo's method on a box given as center and half extents: every axis of the result is the matrix's translation
+ * plus the box's axes put through the matrix, with the extents taking the absolute value so they only ever grow.
+ */
+inline void TransformBox(glm::vec3 &center, glm::vec3 &extents, glm::mat4 const &matrix) {
+    glm::vec3 c = glm::vec3(matrix[3]) + glm::vec3(matrix[0]) * center.x + glm::vec3(matrix[1]) * center.y + glm::vec3(matrix[2]) * center.z;
+    extents = glm::abs(glm::vec3(matrix[0])) * extents.x + glm::abs(glm::vec3(matrix[1])) * extents.y + glm::abs(glm::vec3(matrix[2])) * extents.z;
+    center = c;
+}
+
 #endif //CUTLASS_BOX_H
@@ -0,0 +1,241 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "BoxTree.h"
+
+#include <algorithm>
+
+static float SurfaceArea(Box const &box) {
+    glm::vec3 size = box.max - box.min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+static Box Union(Box const &a, Box const &b) {
+    return Box(glm::min(a.min, b.min), glm::max(a.max, b.max));
+}
+
+static bool Encloses(Box const &outer, Box const &inner) {
+    return glm::all(glm::lessThanEqual(outer.min, inner.min)) && glm::all(glm::greaterThanEqual(outer.max, inner.max));
+}
+
+BoxTree::BoxTree() {
+    this->root = CUT_NULL_PROXY;
+    this->freeNodes = CUT_NULL_PROXY;
+    this->leaves = 0;
+}
+
+int32_t BoxTree::AllocateNode() {
+    if (this->freeNodes == CUT_NULL_PROXY) {
+        this->nodes.emplace_back();
+        this->freeNodes = (int32_t) this->nodes.size() - 1;
+        this->nodes.back().parent = CUT_NULL_PROXY;
+    }
+
+    int32_t node = this->freeNodes;
+    BoxTreeNode &allocated = this->nodes[node];
+    this->freeNodes = allocated.parent;
+
+    allocated.parent = CUT_NULL_PROXY;
+    allocated.children[0] = CUT_NULL_PROXY;
+    allocated.children[1] = CUT_NULL_PROXY;
+    allocated.height = 0;
+    allocated.entity = CUT_NULL_ENTITY;
+    return node;
+}
+
+void BoxTree::FreeNode(int32_t node) {
+    this->nodes[node].parent = this->freeNodes;
+    this->nodes[node].height = -1;
+    this->freeNodes = node;
+}
+
+BoxProxy BoxTree::Create(Box const &box, Entity entity) {
+    int32_t leaf = this->AllocateNode();
+    BoxTreeNode &node = this->nodes[leaf];
+    node.box = Box(box.min - glm::vec3(CUT_BOX_TREE_MARGIN), box.max + glm::vec3(CUT_BOX_TREE_MARGIN));
+    node.entity = entity;
+
+    this->InsertLeaf(leaf);
+    ++this->leaves;
+    return leaf;
+}
+
+void BoxTree::Destroy(BoxProxy proxy) {
+    assert(proxy >= 0 && proxy < (int32_t) this->nodes.size() && this->nodes[proxy].height == 0);
+
+    this->RemoveLeaf(proxy);
+    this->FreeNode(proxy);
+    --this->leaves;
+}
+
+bool BoxTree::Move(BoxProxy proxy, Box const &box, glm::vec3 const &displacement) {
+    assert(proxy >= 0 && proxy < (int32_t) this->nodes.size() && this->nodes[proxy].height == 0);
+
+    if (Encloses(this->nodes[proxy].box, box)) return false;
+
+    /*
+     * it got out, so it's likely to keep going the same way. the new leaf is grown by the margin all around and
+     * stretched ahead of it, so it can carry on for a while before it needs moving again
+     */
+    Box fat(box.min - glm::vec3(CUT_BOX_TREE_MARGIN), box.max + glm::vec3(CUT_BOX_TREE_MARGIN));
+    glm::vec3 ahead = displacement * CUT_BOX_TREE_LOOKAHEAD;
+    fat.min += glm::min(ahead, glm::vec3(0.0f));
+    fat.max += glm::max(ahead, glm::vec3(0.0f));
+
+    this->RemoveLeaf(proxy);
+    this->nodes[proxy].box = fat;
+    this->InsertLeaf(proxy);
+    return true;
+}
+
+void BoxTree::InsertLeaf(int32_t leaf) {
+    if (this->root == CUT_NULL_PROXY) {
+        this->root = leaf;
+        this->nodes[leaf].parent = CUT_NULL_PROXY;
+        return;
+    }
+
+    /*
+     * walks down to the sibling that makes the tree's surface area grow the least. every node it passes grows by
+     * the same amount whichever way it goes, so that's carried down as inherited cost, and it stops once going
+     * further can only cost more than pairing up right here
+     */
+    Box const leafBox = this->nodes[leaf].box;
+    int32_t index = this->root;
+    while (!this->nodes[index].Leaf()) {
+        BoxTreeNode const &node = this->nodes[index];
+        float area = SurfaceArea(node.box);
+        float combinedArea = SurfaceArea(Union(node.box, leafBox));
+
+        // a new parent for this node and the leaf
+        float cost = 2.0f * combinedArea;
+        // the least it costs to push the leaf further down
+        float inherited = 2.0f * (combinedArea - area);
+
+        float childCosts[2];
+        for (int c = 0; c < 2; ++c) {
+            BoxTreeNode const &child = this->nodes[node.children[c]];
+            float grown = SurfaceArea(Union(child.box, leafBox));
+            childCosts[c] = (child.Leaf() ? grown : grown - SurfaceArea(child.box)) + inherited;
+        }
+
+        if (cost < childCosts[0] && cost < childCosts[1]) break;
+        index = node.children[childCosts[0] < childCosts[1] ? 0 : 1];
+    }
+    int32_t sibling = index;
+
+    int32_t oldParent = this->nodes[sibling].parent;
+    int32_t newParent = this->AllocateNode();
+    this->nodes[newParent].parent = oldParent;
+    this->nodes[newParent].box = Union(leafBox, this->nodes[sibling].box);
+    this->nodes[newParent].height = this->nodes[sibling].height + 1;
+    this->nodes[newParent].children[0] = sibling;
+    this->nodes[newParent].children[1] = leaf;
+    this->nodes[sibling].parent = newParent;
+    this->nodes[leaf].parent = newParent;
+
+    if (oldParent == CUT_NULL_PROXY) {
+        this->root = newParent;
+    }
+    else {
+        BoxTreeNode &parent = this->nodes[oldParent];
+        parent.children[parent.children[0] == sibling ? 0 : 1] = newParent;
+    }
+
+    this->Refit(this->nodes[leaf].parent);
+}
+
+void BoxTree::RemoveLeaf(int32_t leaf) {
+    if (leaf == this->root) {
+        this->root = CUT_NULL_PROXY;
+        return;
+    }
+
+    // the leaf's parent goes with it, the sibling takes the parent's place
+    int32_t parent = this->nodes[leaf].parent;
+    int32_t grandParent = this->nodes[parent].parent;
+    int32_t sibling = this->nodes[parent].children[this->nodes[parent].children[0] == leaf ? 1 : 0];
+
+    if (grandParent == CUT_NULL_PROXY) {
+        this->root = sibling;
+        this->nodes[sibling].parent = CUT_NULL_PROXY;
+        this->FreeNode(parent);
+        return;
+    }
+
+    BoxTreeNode &grand = this->nodes[grandParent];
+    grand.children[grand.children[0] == parent ? 0 : 1] = sibling;
+    this->nodes[sibling].parent = grandParent;
+    this->FreeNode(parent);
+
+    this->Refit(grandParent);
+}
+
+/*
+ * walks up from node, rebalancing and fixing boxes and heights as it goes
+ */
+void BoxTree::Refit(int32_t node) {
+    while (node != CUT_NULL_PROXY) {
+        node = this->Balance(node);
+
+        BoxTreeNode &current = this->nodes[node];
+        BoxTreeNode const &a = this->nodes[current.children[0]];
+        BoxTreeNode const &b = this->nodes[current.children[1]];
+        current.height = 1 + std::max(a.height, b.height);
+        current.box = Union(a.box, b.box);
+
+        node = current.parent;
+    }
+}
+
+/*
+ * if one side of a is more than one taller than the other, its root is rotated up into a's place and a takes the
+ * lower of its children. returns whichever node is now where a was
+ */
+int32_t BoxTree::Balance(int32_t a) {
+    BoxTreeNode &nodeA = this->nodes[a];
+    if (nodeA.Leaf() || nodeA.height < 2) return a;
+
+    int32_t b = nodeA.children[0];
+    int32_t c = nodeA.children[1];
+    int32_t balance = this->nodes[c].height - this->nodes[b].height;
+    if (balance >= -1 && balance <= 1) return a;
+
+    // up is the taller child, side the slot it was in, other the one it keeps
+    int side = balance > 1 ? 1 : 0;
+    int32_t up = nodeA.children[side];
+    int32_t other = nodeA.children[1 - side];
+    BoxTreeNode &nodeUp = this->nodes[up];
+    int32_t f = nodeUp.children[0];
+    int32_t g = nodeUp.children[1];
+
+    // up takes a's place
+    nodeUp.children[0] = a;
+    nodeUp.parent = nodeA.parent;
+    nodeA.parent = up;
+    if (nodeUp.parent == CUT_NULL_PROXY) {
+        this->root = up;
+    }
+    else {
+        BoxTreeNode &parent = this->nodes[nodeUp.parent];
+        parent.children[parent.children[0] == a ? 0 : 1] = up;
+    }
+
+    // the taller of up's children stays with it, the other goes down to a
+    int32_t keep = this->nodes[f].height > this->nodes[g].height ? f : g;
+    int32_t give = keep == f ? g : f;
+    nodeUp.children[1] = keep;
+    nodeA.children[side] = give;
+    this->nodes[give].parent = a;
+
+    BoxTreeNode const &nodeOther = this->nodes[other];
+    BoxTreeNode const &nodeGive = this->nodes[give];
+    BoxTreeNode const &nodeKeep = this->nodes[keep];
+    nodeA.box = Union(nodeOther.box, nodeGive.box);
+    nodeA.height = 1 + std::max(nodeOther.height, nodeGive.height);
+    nodeUp.box = Union(nodeA.box, nodeKeep.box);
+    nodeUp.height = 1 + std::max(nodeA.height, nodeKeep.height);
+
+    return up;
+}
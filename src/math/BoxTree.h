@@ -0,0 +1,258 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_BOXTREE_H
+#define CUTLASS_BOXTREE_H
+
+#include <common.h>
+#include "ecs/Entity.h"
+#include "math/Box.h"
+#include "math/Frustum.h"
+#include "math/Ray.h"
+#include "math/RayPacket.h"
+
+#include <cassert>
+#include <cstdint>
+
+#define CUT_NULL_PROXY (-1)
+// how far a leaf's box is grown past what it's given, in world units
+#define CUT_BOX_TREE_MARGIN 4.0f
+// a moving leaf's box is stretched this many steps ahead of it
+#define CUT_BOX_TREE_LOOKAHEAD 2.0f
+// deep enough for any balanced tree that fits in memory
+#define CUT_BOX_TREE_STACK 256
+
+typedef int32_t BoxProxy;
+
+/*
+ * one node of the tree. leaves hold an entity and a box grown by CUT_BOX_TREE_MARGIN, inner nodes hold the box around
+ * both children. free nodes link through parent, and have a height of -1.
+ */
+struct BoxTreeNode {
+    Box box;
+    int32_t parent;
+    int32_t children[2];
+    int32_t height;
+    Entity entity;
+
+    bool Leaf() const { return this->children[0] == CUT_NULL_PROXY; }
+};
+
+/*
+ * dynamic bounding volume hierarchy over boxes, for "what's near here" questions: overlap, ray and frustum queries.
+ *
+ * leaves are grown a little past the box they're given, so something that moves only a bit stays in its leaf and
+ * Move() costs a containment test. one that leaves it is taken out and inserted again where it adds the least
+ * surface area, and every node on the way back up is rebalanced with AVL style rotations, so the tree stays about
+ * log2(count) deep however things move. nodes come out of one array and link by index.
+ *
+ * queries only read, so any number can run at once as long as nothing changes the tree meanwhile.
+ */
+class BoxTree {
+public:
+    BoxTree();
+
+    BoxProxy Create(Box const &box, Entity entity);
+    void Destroy(BoxProxy proxy);
+    // displacement is how far it moved this step, the leaf is stretched that way. returns whether the leaf was
+    // reinserted
+    bool Move(BoxProxy proxy, Box const &box, glm::vec3 const &displacement = glm::vec3(0.0f));
+
+    Entity GetEntity(BoxProxy proxy) const { return this->nodes[proxy].entity; }
+    // the grown box, which queries go by
+    Box const &GetBox(BoxProxy proxy) const { return this->nodes[proxy].box; }
+
+    size_t Count() const { return this->leaves; }
+    int32_t Height() const { return this->root == CUT_NULL_PROXY ? 0 : this->nodes[this->root].height; }
+
+    // func(Entity, BoxProxy) for every leaf whose box overlaps box, until it returns false
+    template<typename Func>
+    void Query(Box const &box, Func &&func) const;
+
+    // func(Entity, BoxProxy) for every leaf at least partly inside the frustum, until it returns false
+    template<typename Func>
+    void Query(Frustum const &frustum, Func &&func) const;
+
+    /*
+     * func(Entity, BoxProxy, float distance) for every leaf the ray enters within maxDistance, nearest subtrees first
+     * but not strictly in order. func returns the new maxDistance: its own hit to only look for closer ones, the
+     * one it was given to carry on, or 0 to stop.
+     */
+    template<typename Func>
+    void RayCast(Ray const &ray, float maxDistance, Func &&func) const;
+
+    /*
+     * a packet of rays at once, each node is tested against all of them with one slab test. func(Entity, BoxProxy,
+     * uint32_t lanes) is called for every leaf some of the lanes enter, with those lanes' bits set. it lowers the
+     * packet's maxDistance for lanes that hit something, so the rest of the search only looks closer.
+     */
+    template<typename Func>
+    void RayCast(RayPacket &packet, Func &&func) const;
+
+private:
+    std::vector<BoxTreeNode> nodes;
+    int32_t root;
+    int32_t freeNodes;
+    size_t leaves;
+
+    int32_t AllocateNode();
+    void FreeNode(int32_t node);
+
+    void InsertLeaf(int32_t leaf);
+    void RemoveLeaf(int32_t leaf);
+    int32_t Balance(int32_t node);
+    void Refit(int32_t node);
+};
+
+template<typename Func>
+void BoxTree::Query(Box const &box, Func &&func) const {
+    int32_t stack[CUT_BOX_TREE_STACK];
+    int count = 0;
+    if (this->root != CUT_NULL_PROXY) stack[count++] = this->root;
+
+    while (count) {
+        BoxTreeNode const &node = this->nodes[stack[--count]];
+        if (!node.box.Overlaps(box)) continue;
+
+        if (node.Leaf()) {
+            if (!func(node.entity, (BoxProxy) (&node - this->nodes.data()))) return;
+            continue;
+        }
+
+        assert(count + 2 <= CUT_BOX_TREE_STACK);
+        stack[count++] = node.children[0];
+        stack[count++] = node.children[1];
+    }
+}
+
+template<typename Func>
+void BoxTree::Query(Frustum const &frustum, Func &&func) const {
+    /*
+     * every node carries the planes its parent wasn't already wholly inside of, only those need testing further
+     * down. once there are none left, the whole subtree is in view and its leaves are reported without tests
+     */
+    int32_t stack[CUT_BOX_TREE_STACK];
+    uint8_t planes[CUT_BOX_TREE_STACK];
+    int count = 0;
+    if (this->root != CUT_NULL_PROXY) {
+        stack[count] = this->root;
+        planes[count++] = (1 << CUT_FRUSTUM_PLANES) - 1;
+    }
+
+    while (count) {
+        --count;
+        BoxTreeNode const &node = this->nodes[stack[count]];
+        uint8_t straddled = planes[count];
+
+        if (straddled) {
+            glm::vec3 center = node.box.Center();
+            glm::vec3 extents = node.box.Extents();
+            bool outside = false;
+            for (int p = 0; p < CUT_FRUSTUM_PLANES && !outside; ++p) {
+                if (!(straddled & (1 << p))) continue;
+
+                Plane const &plane = frustum.planes[p];
+                float distance = plane.Distance(center);
+                float radius = glm::dot(glm::abs(plane.normal), extents);
+                if (distance + radius < 0.0f) outside = true;
+                else if (distance - radius >= 0.0f) straddled &= ~(1 << p);
+            }
+            if (outside) continue;
+        }
+
+        if (node.Leaf()) {
+            if (!func(node.entity, (BoxProxy) (&node - this->nodes.data()))) return;
+            continue;
+        }
+
+        assert(count + 2 <= CUT_BOX_TREE_STACK);
+        stack[count] = node.children[0];
+        planes[count++] = straddled;
+        stack[count] = node.children[1];
+        planes[count++] = straddled;
+    }
+}
+
+template<typename Func>
+void BoxTree::RayCast(Ray const &ray, float maxDistance, Func &&func) const {
+    glm::vec3 inverse = 1.0f / ray.direction;
+
+    // nodes are tested before they go on the stack, the distance the ray enters them at comes along
+    int32_t stack[CUT_BOX_TREE_STACK];
+    float entered[CUT_BOX_TREE_STACK];
+    int count = 0;
+    float distance;
+    if (this->root != CUT_NULL_PROXY && IntersectSlabs(ray.origin, inverse, this->nodes[this->root].box, maxDistance, distance)) {
+        stack[count] = this->root;
+        entered[count++] = distance;
+    }
+
+    while (count) {
+        --count;
+        // a hit since it was pushed may have put it out of reach
+        if (entered[count] > maxDistance) continue;
+        BoxTreeNode const &node = this->nodes[stack[count]];
+
+        if (node.Leaf()) {
+            maxDistance = func(node.entity, (BoxProxy) (&node - this->nodes.data()), entered[count]);
+            if (maxDistance <= 0.0f) return;
+            continue;
+        }
+
+        // the nearer child goes on top, so it's searched first and can shorten the ray for the other
+        float near[2];
+        bool hit[2];
+        for (int c = 0; c < 2; ++c) hit[c] = IntersectSlabs(ray.origin, inverse, this->nodes[node.children[c]].box, maxDistance, near[c]);
+        int first = hit[0] && (!hit[1] || near[0] <= near[1]) ? 0 : 1;
+
+        assert(count + 2 <= CUT_BOX_TREE_STACK);
+        if (hit[1 - first]) {
+            stack[count] = node.children[1 - first];
+            entered[count++] = near[1 - first];
+        }
+        if (hit[first]) {
+            stack[count] = node.children[first];
+            entered[count++] = near[first];
+        }
+    }
+}
+
+template<typename Func>
+void BoxTree::RayCast(RayPacket &packet, Func &&func) const {
+    if (this->root == CUT_NULL_PROXY) return;
+
+    // the packet's rays are expected to head roughly the same way, the first one in use stands in for all of them
+    glm::vec3 heading(1.0f);
+    for (uint32_t lane = 0; lane < CUT_RAY_PACKET; ++lane) {
+        if (packet.maxDistance[lane] < 0.0f) continue;
+        heading = glm::sign(glm::vec3(packet.inverse[0][lane], packet.inverse[1][lane], packet.inverse[2][lane]));
+        break;
+    }
+
+    int32_t stack[CUT_BOX_TREE_STACK];
+    int count = 0;
+    stack[count++] = this->root;
+
+    while (count) {
+        BoxTreeNode const &node = this->nodes[stack[--count]];
+        uint32_t lanes = packet.Intersects(node.box);
+        if (!lanes) continue;
+
+        if (node.Leaf()) {
+            func(node.entity, (BoxProxy) (&node - this->nodes.data()), lanes);
+            continue;
+        }
+
+        // the child further along the heading goes underneath, so the nearer one is searched first
+        BoxTreeNode const &a = this->nodes[node.children[0]];
+        BoxTreeNode const &b = this->nodes[node.children[1]];
+        bool aFirst = glm::dot(b.box.Center() - a.box.Center(), heading) >= 0.0f;
+
+        assert(count + 2 <= CUT_BOX_TREE_STACK);
+        stack[count++] = node.children[aFirst ? 1 : 0];
+        stack[count++] = node.children[aFirst ? 0 : 1];
+    }
+}
+
+#endif //CUTLASS_BOXTREE_H
@@ -0,0 +1,116 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "Frustum.h"
+
+#include <glm/simd/platform.h>
+
+#include <algorithm>
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#include <immintrin.h>
+#endif
+
+Frustum::Frustum(glm::mat4 const &viewProjection) {
+    /*
+     * Gribb and Hartmann: a point is inside when -w <= x, y, z <= w in clip space, and each of those six tests is a
+     * plane in whatever space the matrix takes points from. row 3 is w, rows 0 to 2 are x, y and z.
+     */
+    glm::mat4 rows = glm::transpose(viewProjection);
+
+    this->planes[CUT_FRUSTUM_LEFT] = Plane(rows[3] + rows[0]);
+    this->planes[CUT_FRUSTUM_RIGHT] = Plane(rows[3] - rows[0]);
+    this->planes[CUT_FRUSTUM_BOTTOM] = Plane(rows[3] + rows[1]);
+    this->planes[CUT_FRUSTUM_TOP] = Plane(rows[3] - rows[1]);
+    this->planes[CUT_FRUSTUM_NEAR] = Plane(rows[3] + rows[2]);
+    this->planes[CUT_FRUSTUM_FAR] = Plane(rows[3] - rows[2]);
+}
+
+bool Frustum::Intersects(glm::vec3 const &center, glm::vec3 const &extents) const {
+    // the box is behind a plane when even its corner furthest along the normal is
+    for (Plane const &plane : this->planes) {
+        if (plane.Distance(center) + glm::dot(glm::abs(plane.normal), extents) < 0.0f) return false;
+    }
+    return true;
+}
+
+size_t CullBoxes(Frustum const &frustum, BoxArrays const &boxes, size_t count, uint32_t *visible) {
+    float const *cx = boxes.center[0], *cy = boxes.center[1], *cz = boxes.center[2];
+    float const *ex = boxes.extents[0], *ey = boxes.extents[1], *ez = boxes.extents[2];
+
+    size_t i = 0;
+    size_t visibleCount = 0;
+
+    // normal, distance and the normal's absolute value, ready to broadcast
+    float planes[CUT_FRUSTUM_PLANES][7];
+    for (int p = 0; p < CUT_FRUSTUM_PLANES; ++p) {
+        Plane const &plane = frustum.planes[p];
+        glm::vec3 absolute = glm::abs(plane.normal);
+        float values[7] = {plane.normal.x, plane.normal.y, plane.normal.z, plane.distance, absolute.x, absolute.y, absolute.z};
+        std::copy(values, values + 7, planes[p]);
+    }
+
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(cx + i), y = _mm256_loadu_ps(cy + i), z = _mm256_loadu_ps(cz + i);
+        __m256 sx = _mm256_loadu_ps(ex + i), sy = _mm256_loadu_ps(ey + i), sz = _mm256_loadu_ps(ez + i);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < CUT_FRUSTUM_PLANES; ++p) {
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(planes[p][0])), _mm256_set1_ps(planes[p][3]));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(y, _mm256_set1_ps(planes[p][1])));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(z, _mm256_set1_ps(planes[p][2])));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(sx, _mm256_set1_ps(planes[p][4])));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(sy, _mm256_set1_ps(planes[p][5])));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(sz, _mm256_set1_ps(planes[p][6])));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+
+        // every lane is written, only the visible ones are kept
+        auto mask = (uint32_t) _mm256_movemask_ps(inside);
+        for (uint32_t lane = 0; lane < 8; ++lane) {
+            visible[visibleCount] = (uint32_t) i + lane;
+            visibleCount += (mask >> lane) & 1;
+        }
+    }
+#endif
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    // sse2 can't broadcast straight from memory
+    __m128 broadcast[CUT_FRUSTUM_PLANES][7];
+    for (int p = 0; p < CUT_FRUSTUM_PLANES; ++p) {
+        for (int v = 0; v < 7; ++v) broadcast[p][v] = _mm_set1_ps(planes[p][v]);
+    }
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(cx + i), y = _mm_loadu_ps(cy + i), z = _mm_loadu_ps(cz + i);
+        __m128 sx = _mm_loadu_ps(ex + i), sy = _mm_loadu_ps(ey + i), sz = _mm_loadu_ps(ez + i);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < CUT_FRUSTUM_PLANES; ++p) {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(x, broadcast[p][0]), broadcast[p][3]);
+            distance = _mm_add_ps(distance, _mm_mul_ps(y, broadcast[p][1]));
+            distance = _mm_add_ps(distance, _mm_mul_ps(z, broadcast[p][2]));
+            distance = _mm_add_ps(distance, _mm_mul_ps(sx, broadcast[p][4]));
+            distance = _mm_add_ps(distance, _mm_mul_ps(sy, broadcast[p][5]));
+            distance = _mm_add_ps(distance, _mm_mul_ps(sz, broadcast[p][6]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+        }
+
+        auto mask = (uint32_t) _mm_movemask_ps(inside);
+        for (uint32_t lane = 0; lane < 4; ++lane) {
+            visible[visibleCount] = (uint32_t) i + lane;
+            visibleCount += (mask >> lane) & 1;
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        if (frustum.Intersects(glm::vec3(cx[i], cy[i], cz[i]), glm::vec3(ex[i], ey[i], ez[i]))) {
+            visible[visibleCount++] = (uint32_t) i;
+        }
+    }
+
+    return visibleCount;
+}
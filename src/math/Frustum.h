@@ -0,0 +1,53 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_FRUSTUM_H
+#define CUTLASS_FRUSTUM_H
+
+#include "math/Box.h"
+#include "math/Plane.h"
+
+#include <cstdint>
+
+enum FrustumPlane {
+    CUT_FRUSTUM_LEFT,
+    CUT_FRUSTUM_RIGHT,
+    CUT_FRUSTUM_BOTTOM,
+    CUT_FRUSTUM_TOP,
+    CUT_FRUSTUM_NEAR,
+    CUT_FRUSTUM_FAR,
+    CUT_FRUSTUM_PLANES
+};
+
+/*
+ * the six planes around what a camera sees, facing inwards
+ */
+struct Frustum {
+    Plane planes[CUT_FRUSTUM_PLANES];
+
+    Frustum() = default;
+    // projection * view, or projection * view * model for a frustum in the model's space. GL clip space, z in [-w, w]
+    explicit Frustum(glm::mat4 const &viewProjection);
+
+    // conservative: a box near a corner of the frustum may pass without being in it
+    bool Intersects(glm::vec3 const &center, glm::vec3 const &extents) const;
+    bool Intersects(Box const &box) const { return this->Intersects(box.Center(), box.Extents()); }
+};
+
+/*
+ * boxes as centers and half extents, one array per axis, so they can be read several at a time
+ */
+struct BoxArrays {
+    float const *center[3];
+    float const *extents[3];
+};
+
+/*
+ * writes the indices of the boxes that are at least partly inside the frustum to visible, in order, and returns how
+ * many there are. visible needs room for count indices. four or eight boxes are tested against all six planes at
+ * once, depending on what glm was built for.
+ */
+size_t CullBoxes(Frustum const &frustum, BoxArrays const &boxes, size_t count, uint32_t *visible);
+
+#endif //CUTLASS_FRUSTUM_H
@@ -0,0 +1,129 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "MatrixKernels.h"
+
+#include <cstdint>
+
+#if CUT_MATRIX_KERNELS_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+static void BuildModelsScalar(float *out, size_t outStride, float const *trs, size_t trsStride, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        auto t = (float const *) ((char const *) trs + i * trsStride);
+        auto m = (float *) ((char *) out + i * outStride);
+
+        float x = t[3], y = t[4], z = t[5], w = t[6];
+        float xx = x * x, yy = y * y, zz = z * z;
+        float xy = x * y, xz = x * z, yz = y * z;
+        float wx = w * x, wy = w * y, wz = w * z;
+
+        m[0] = (1.0f - 2.0f * (yy + zz)) * t[7];
+        m[1] = 2.0f * (xy + wz) * t[7];
+        m[2] = 2.0f * (xz - wy) * t[7];
+        m[3] = 0.0f;
+        m[4] = 2.0f * (xy - wz) * t[8];
+        m[5] = (1.0f - 2.0f * (xx + zz)) * t[8];
+        m[6] = 2.0f * (yz + wx) * t[8];
+        m[7] = 0.0f;
+        m[8] = 2.0f * (xz + wy) * t[9];
+        m[9] = 2.0f * (yz - wx) * t[9];
+        m[10] = (1.0f - 2.0f * (xx + yy)) * t[9];
+        m[11] = 0.0f;
+        m[12] = t[0];
+        m[13] = t[1];
+        m[14] = t[2];
+        m[15] = 1.0f;
+    }
+}
+
+static void MultiplyScalar(float *out, size_t outStride, float const *left, float const *right, size_t rightStride, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        auto r = (float const *) ((char const *) right + i * rightStride);
+        auto m = (float *) ((char *) out + i * outStride);
+
+        // right may be out, so the column is done on a copy
+        for (int column = 0; column < 4; ++column) {
+            float c[4] = {r[column * 4], r[column * 4 + 1], r[column * 4 + 2], r[column * 4 + 3]};
+            for (int row = 0; row < 4; ++row) {
+                m[column * 4 + row] = left[row] * c[0] + left[4 + row] * c[1] + left[8 + row] * c[2] + left[12 + row] * c[3];
+            }
+        }
+    }
+}
+
+static const MatrixKernels scalarKernels = {"scalar", BuildModelsScalar, MultiplyScalar};
+
+#if CUT_MATRIX_KERNELS_X86
+
+enum CPUFeatures {
+    CUT_CPU_AVX2 = 1,
+    CUT_CPU_AVX512 = 2,
+};
+
+static void CPUID(uint32_t leaf, uint32_t subleaf, uint32_t registers[4]) {
+#ifdef _MSC_VER
+    __cpuidex((int *) registers, (int) leaf, (int) subleaf);
+#else
+    __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+// which register state the OS saves on a context switch, the wide registers are only usable if it saves them
+static uint64_t EnabledRegisterState() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    uint32_t low, high;
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return ((uint64_t) high << 32) | low;
+#endif
+}
+
+static int DetectCPUFeatures() {
+    uint32_t registers[4];
+    CPUID(0, 0, registers);
+    if (registers[0] < 7) return 0;
+
+    // avx, fma and osxsave
+    CPUID(1, 0, registers);
+    uint32_t const leaf1 = (1u << 12) | (1u << 27) | (1u << 28);
+    if ((registers[2] & leaf1) != leaf1) return 0;
+
+    uint64_t state = EnabledRegisterState();
+    // sse and avx state
+    if ((state & 0x6) != 0x6) return 0;
+
+    CPUID(7, 0, registers);
+    int features = 0;
+    if (registers[1] & (1u << 5)) features |= CUT_CPU_AVX2;
+    // avx512f, plus the opmask and upper zmm state
+    if ((features & CUT_CPU_AVX2) && (registers[1] & (1u << 16)) && (state & 0xE6) == 0xE6) features |= CUT_CPU_AVX512;
+    return features;
+}
+
+#endif
+
+std::vector<MatrixKernels const *> SupportedMatrixKernels() {
+    std::vector<MatrixKernels const *> supported = {&scalarKernels};
+
+#if CUT_MATRIX_KERNELS_X86
+    int features = DetectCPUFeatures();
+    if (SSE2MatrixKernels()) supported.push_back(SSE2MatrixKernels());
+    if ((features & CUT_CPU_AVX2) && AVX2MatrixKernels()) supported.push_back(AVX2MatrixKernels());
+    if ((features & CUT_CPU_AVX512) && AVX512MatrixKernels()) supported.push_back(AVX512MatrixKernels());
+#endif
+
+    return supported;
+}
+
+MatrixKernels const &GetMatrixKernels() {
+    static MatrixKernels const &kernels = *SupportedMatrixKernels().back();
+    return kernels;
+}
@@ -0,0 +1,46 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_MATRIXKERNELS_H
+#define CUTLASS_MATRIXKERNELS_H
+
+#include <cstddef>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || ((defined(__i386__) || defined(_M_IX86)) && defined(__SSE2__))
+#define CUT_MATRIX_KERNELS_X86 1
+#else
+#define CUT_MATRIX_KERNELS_X86 0
+#endif
+
+/*
+ * batch matrix math, in versions for SSE2, AVX2 and AVX-512 that are all in the binary. the best one the CPU runs is
+ * picked the first time GetMatrixKernels() is called, so a generic build still gets the wide paths where there are.
+ *
+ * everything is raw floats. a TRS is position xyz, rotation xyzw (a unit quaternion) and scale xyz, 10 floats in a
+ * row, which is how Transform starts. matrices are 16 floats, column major like glm. strides are in bytes, so
+ * inputs and outputs can be fields of bigger structs.
+ *
+ * the wide versions are compiled with their instruction sets turned on, so they mustn't include glm or anything
+ * else with inline functions: the linker could keep their copy and hand it to code running on any CPU.
+ */
+struct MatrixKernels {
+    const char *name;
+
+    // out[i] = translate * rotate * scale of trs[i]
+    void (*buildModels)(float *out, size_t outStride, float const *trs, size_t trsStride, size_t count);
+    // out[i] = left * right[i]
+    void (*multiply)(float *out, size_t outStride, float const *left, float const *right, size_t rightStride, size_t count);
+};
+
+MatrixKernels const &GetMatrixKernels();
+// every version this CPU runs, slowest first
+std::vector<MatrixKernels const *> SupportedMatrixKernels();
+
+// the versions compiled in, nullptr for the ones the compiler wasn't given the instruction set for
+MatrixKernels const *SSE2MatrixKernels();
+MatrixKernels const *AVX2MatrixKernels();
+MatrixKernels const *AVX512MatrixKernels();
+
+#endif //CUTLASS_MATRIXKERNELS_H
@@ -0,0 +1,122 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "MatrixKernels.h"
+
+// built with -mavx2 -mfma (/arch:AVX2 on MSVC), see CMakeLists.txt
+#if CUT_MATRIX_KERNELS_X86 && defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+
+#include <immintrin.h>
+
+// transposes the 4x4 blocks in each 128 bit half
+static inline void Transpose(__m256 &a, __m256 &b, __m256 &c, __m256 &d) {
+    __m256 t0 = _mm256_unpacklo_ps(a, b), t1 = _mm256_unpackhi_ps(a, b);
+    __m256 t2 = _mm256_unpacklo_ps(c, d), t3 = _mm256_unpackhi_ps(c, d);
+    a = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    b = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    c = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    d = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+static inline __m256 Load(float const *low, float const *high) {
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+}
+
+static inline __m256 LoadPair(float const *low, float const *high) {
+    __m128 zero = _mm_setzero_ps();
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadl_pi(zero, (__m64 const *) low)), _mm_loadl_pi(zero, (__m64 const *) high), 1);
+}
+
+/*
+ * eight transforms at a time, see BuildFour in the SSE2 version. lane k of a 128 bit half is transform k, or k + 4
+ * in the upper half.
+ */
+static void BuildEight(float *const out[8], float const *const trs[8]) {
+    __m256 px = Load(trs[0], trs[4]), py = Load(trs[1], trs[5]), pz = Load(trs[2], trs[6]), x = Load(trs[3], trs[7]);
+    Transpose(px, py, pz, x);
+    __m256 y = Load(trs[0] + 4, trs[4] + 4), z = Load(trs[1] + 4, trs[5] + 4);
+    __m256 w = Load(trs[2] + 4, trs[6] + 4), sx = Load(trs[3] + 4, trs[7] + 4);
+    Transpose(y, z, w, sx);
+    __m256 sy = LoadPair(trs[0] + 8, trs[4] + 8), sz = LoadPair(trs[1] + 8, trs[5] + 8);
+    __m256 s2 = LoadPair(trs[2] + 8, trs[6] + 8), s3 = LoadPair(trs[3] + 8, trs[7] + 8);
+    Transpose(sy, sz, s2, s3);
+
+    __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f), two = _mm256_set1_ps(2.0f);
+    __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+    __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+    __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+    __m256 c[4][4] = {
+            {_mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(yy, zz), one), sx),
+                    _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), sx),
+                    _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), sx), zero},
+            {_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), sy),
+                    _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(xx, zz), one), sy),
+                    _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), sy), zero},
+            {_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), sz),
+                    _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), sz),
+                    _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(xx, yy), one), sz), zero},
+            {px, py, pz, one},
+    };
+
+    for (int column = 0; column < 4; ++column) {
+        Transpose(c[column][0], c[column][1], c[column][2], c[column][3]);
+        for (int lane = 0; lane < 4; ++lane) {
+            _mm_storeu_ps(out[lane] + column * 4, _mm256_castps256_ps128(c[column][lane]));
+            _mm_storeu_ps(out[lane + 4] + column * 4, _mm256_extractf128_ps(c[column][lane], 1));
+        }
+    }
+}
+
+static void BuildModelsAVX2(float *out, size_t outStride, float const *trs, size_t trsStride, size_t count) {
+    float scratch[16];
+
+    for (size_t i = 0; i < count; i += 8) {
+        float *outs[8];
+        float const *ins[8];
+        for (size_t lane = 0; lane < 8; ++lane) {
+            bool used = i + lane < count;
+            size_t at = used ? i + lane : count - 1;
+            outs[lane] = used ? (float *) ((char *) out + at * outStride) : scratch;
+            ins[lane] = (float const *) ((char const *) trs + at * trsStride);
+        }
+        BuildEight(outs, ins);
+    }
+}
+
+/*
+ * two columns of the right matrix per register, against the left matrix's columns repeated in both halves
+ */
+static void MultiplyAVX2(float *out, size_t outStride, float const *left, float const *right, size_t rightStride, size_t count) {
+    __m256 l0 = Load(left, left), l1 = Load(left + 4, left + 4), l2 = Load(left + 8, left + 8), l3 = Load(left + 12, left + 12);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto r = (float const *) ((char const *) right + i * rightStride);
+        auto m = (float *) ((char *) out + i * outStride);
+
+        __m256 columns[2] = {_mm256_loadu_ps(r), _mm256_loadu_ps(r + 8)};
+        for (__m256 &c : columns) {
+            __m256 sum = _mm256_mul_ps(l0, _mm256_permute_ps(c, 0x00));
+            sum = _mm256_fmadd_ps(l1, _mm256_permute_ps(c, 0x55), sum);
+            sum = _mm256_fmadd_ps(l2, _mm256_permute_ps(c, 0xAA), sum);
+            c = _mm256_fmadd_ps(l3, _mm256_permute_ps(c, 0xFF), sum);
+        }
+        _mm256_storeu_ps(m, columns[0]);
+        _mm256_storeu_ps(m + 8, columns[1]);
+    }
+}
+
+static const MatrixKernels avx2Kernels = {"avx2", BuildModelsAVX2, MultiplyAVX2};
+
+MatrixKernels const *AVX2MatrixKernels() {
+    return &avx2Kernels;
+}
+
+#else
+
+MatrixKernels const *AVX2MatrixKernels() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,141 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "MatrixKernels.h"
+
+// built with -mavx512f -mfma (/arch:AVX512 on MSVC), see CMakeLists.txt
+#if CUT_MATRIX_KERNELS_X86 && defined(__AVX512F__)
+
+/*
+ * GCC 12 before 12.3 warns from inside its own AVX-512 headers wherever unpack, permute, broadcast or extract get
+ * inlined (GCC bug 105593). the pragma has to be in place when the header is read.
+ */
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ == 12 && __GNUC_MINOR__ < 3
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+
+// transposes the 4x4 blocks in each 128 bit quarter
+static inline void Transpose(__m512 &a, __m512 &b, __m512 &c, __m512 &d) {
+    __m512 t0 = _mm512_unpacklo_ps(a, b), t1 = _mm512_unpackhi_ps(a, b);
+    __m512 t2 = _mm512_unpacklo_ps(c, d), t3 = _mm512_unpackhi_ps(c, d);
+    a = _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    b = _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    c = _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    d = _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+// quarter q gets four floats from p[q]
+static inline __m512 Load(float const *const p[4], size_t offset) {
+    __m512 v = _mm512_zextps128_ps512(_mm_loadu_ps(p[0] + offset));
+    v = _mm512_insertf32x4(v, _mm_loadu_ps(p[1] + offset), 1);
+    v = _mm512_insertf32x4(v, _mm_loadu_ps(p[2] + offset), 2);
+    return _mm512_insertf32x4(v, _mm_loadu_ps(p[3] + offset), 3);
+}
+
+static inline __m512 LoadPair(float const *const p[4], size_t offset) {
+    __m128 zero = _mm_setzero_ps();
+    __m512 v = _mm512_zextps128_ps512(_mm_loadl_pi(zero, (__m64 const *) (p[0] + offset)));
+    v = _mm512_insertf32x4(v, _mm_loadl_pi(zero, (__m64 const *) (p[1] + offset)), 1);
+    v = _mm512_insertf32x4(v, _mm_loadl_pi(zero, (__m64 const *) (p[2] + offset)), 2);
+    return _mm512_insertf32x4(v, _mm_loadl_pi(zero, (__m64 const *) (p[3] + offset)), 3);
+}
+
+/*
+ * sixteen transforms at a time, see BuildFour in the SSE2 version. lane k of quarter q is transform k + 4q.
+ */
+static void BuildSixteen(float *const out[16], float const *const trs[16]) {
+    float const *const lanes[4][4] = {
+            {trs[0], trs[4], trs[8], trs[12]},
+            {trs[1], trs[5], trs[9], trs[13]},
+            {trs[2], trs[6], trs[10], trs[14]},
+            {trs[3], trs[7], trs[11], trs[15]},
+    };
+
+    __m512 px = Load(lanes[0], 0), py = Load(lanes[1], 0), pz = Load(lanes[2], 0), x = Load(lanes[3], 0);
+    Transpose(px, py, pz, x);
+    __m512 y = Load(lanes[0], 4), z = Load(lanes[1], 4), w = Load(lanes[2], 4), sx = Load(lanes[3], 4);
+    Transpose(y, z, w, sx);
+    __m512 sy = LoadPair(lanes[0], 8), sz = LoadPair(lanes[1], 8), s2 = LoadPair(lanes[2], 8), s3 = LoadPair(lanes[3], 8);
+    Transpose(sy, sz, s2, s3);
+
+    __m512 zero = _mm512_setzero_ps(), one = _mm512_set1_ps(1.0f), two = _mm512_set1_ps(2.0f);
+    __m512 xx = _mm512_mul_ps(x, x), yy = _mm512_mul_ps(y, y), zz = _mm512_mul_ps(z, z);
+    __m512 xy = _mm512_mul_ps(x, y), xz = _mm512_mul_ps(x, z), yz = _mm512_mul_ps(y, z);
+    __m512 wx = _mm512_mul_ps(w, x), wy = _mm512_mul_ps(w, y), wz = _mm512_mul_ps(w, z);
+
+    __m512 c[4][4] = {
+            {_mm512_mul_ps(_mm512_fnmadd_ps(two, _mm512_add_ps(yy, zz), one), sx),
+                    _mm512_mul_ps(_mm512_mul_ps(two, _mm512_add_ps(xy, wz)), sx),
+                    _mm512_mul_ps(_mm512_mul_ps(two, _mm512_sub_ps(xz, wy)), sx), zero},
+            {_mm512_mul_ps(_mm512_mul_ps(two, _mm512_sub_ps(xy, wz)), sy),
+                    _mm512_mul_ps(_mm512_fnmadd_ps(two, _mm512_add_ps(xx, zz), one), sy),
+                    _mm512_mul_ps(_mm512_mul_ps(two, _mm512_add_ps(yz, wx)), sy), zero},
+            {_mm512_mul_ps(_mm512_mul_ps(two, _mm512_add_ps(xz, wy)), sz),
+                    _mm512_mul_ps(_mm512_mul_ps(two, _mm512_sub_ps(yz, wx)), sz),
+                    _mm512_mul_ps(_mm512_fnmadd_ps(two, _mm512_add_ps(xx, yy), one), sz), zero},
+            {px, py, pz, one},
+    };
+
+    for (int column = 0; column < 4; ++column) {
+        Transpose(c[column][0], c[column][1], c[column][2], c[column][3]);
+        for (int lane = 0; lane < 4; ++lane) {
+            __m512 v = c[column][lane];
+            _mm_storeu_ps(out[lane] + column * 4, _mm512_castps512_ps128(v));
+            _mm_storeu_ps(out[lane + 4] + column * 4, _mm512_extractf32x4_ps(v, 1));
+            _mm_storeu_ps(out[lane + 8] + column * 4, _mm512_extractf32x4_ps(v, 2));
+            _mm_storeu_ps(out[lane + 12] + column * 4, _mm512_extractf32x4_ps(v, 3));
+        }
+    }
+}
+
+static void BuildModelsAVX512(float *out, size_t outStride, float const *trs, size_t trsStride, size_t count) {
+    float scratch[16];
+
+    for (size_t i = 0; i < count; i += 16) {
+        float *outs[16];
+        float const *ins[16];
+        for (size_t lane = 0; lane < 16; ++lane) {
+            bool used = i + lane < count;
+            size_t at = used ? i + lane : count - 1;
+            outs[lane] = used ? (float *) ((char *) out + at * outStride) : scratch;
+            ins[lane] = (float const *) ((char const *) trs + at * trsStride);
+        }
+        BuildSixteen(outs, ins);
+    }
+}
+
+/*
+ * a whole right matrix per register, against the left matrix's columns repeated in every quarter
+ */
+static void MultiplyAVX512(float *out, size_t outStride, float const *left, float const *right, size_t rightStride, size_t count) {
+    __m512 l0 = _mm512_broadcast_f32x4(_mm_loadu_ps(left)), l1 = _mm512_broadcast_f32x4(_mm_loadu_ps(left + 4));
+    __m512 l2 = _mm512_broadcast_f32x4(_mm_loadu_ps(left + 8)), l3 = _mm512_broadcast_f32x4(_mm_loadu_ps(left + 12));
+
+    for (size_t i = 0; i < count; ++i) {
+        auto r = (float const *) ((char const *) right + i * rightStride);
+        auto m = (float *) ((char *) out + i * outStride);
+
+        __m512 c = _mm512_loadu_ps(r);
+        __m512 sum = _mm512_mul_ps(l0, _mm512_permute_ps(c, 0x00));
+        sum = _mm512_fmadd_ps(l1, _mm512_permute_ps(c, 0x55), sum);
+        sum = _mm512_fmadd_ps(l2, _mm512_permute_ps(c, 0xAA), sum);
+        _mm512_storeu_ps(m, _mm512_fmadd_ps(l3, _mm512_permute_ps(c, 0xFF), sum));
+    }
+}
+
+static const MatrixKernels avx512Kernels = {"avx512", BuildModelsAVX512, MultiplyAVX512};
+
+MatrixKernels const *AVX512MatrixKernels() {
+    return &avx512Kernels;
+}
+
+#else
+
+MatrixKernels const *AVX512MatrixKernels() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,99 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "MatrixKernels.h"
+
+#if CUT_MATRIX_KERNELS_X86
+
+#include <emmintrin.h>
+
+/*
+ * four transforms at a time, one per lane. the transforms are transposed on the way in and the matrices on the way
+ * out, in between every lane does the same thing as Transform::Model().
+ */
+static void BuildFour(float *const out[4], float const *const trs[4]) {
+    __m128 px = _mm_loadu_ps(trs[0]), py = _mm_loadu_ps(trs[1]), pz = _mm_loadu_ps(trs[2]), x = _mm_loadu_ps(trs[3]);
+    _MM_TRANSPOSE4_PS(px, py, pz, x);
+    __m128 y = _mm_loadu_ps(trs[0] + 4), z = _mm_loadu_ps(trs[1] + 4), w = _mm_loadu_ps(trs[2] + 4), sx = _mm_loadu_ps(trs[3] + 4);
+    _MM_TRANSPOSE4_PS(y, z, w, sx);
+
+    // only two floats are left, so nothing past the end of the last transform is read
+    __m128 zero = _mm_setzero_ps();
+    __m128 sy = _mm_loadl_pi(zero, (__m64 const *) (trs[0] + 8)), sz = _mm_loadl_pi(zero, (__m64 const *) (trs[1] + 8));
+    __m128 s2 = _mm_loadl_pi(zero, (__m64 const *) (trs[2] + 8)), s3 = _mm_loadl_pi(zero, (__m64 const *) (trs[3] + 8));
+    _MM_TRANSPOSE4_PS(sy, sz, s2, s3);
+
+    __m128 one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f);
+    __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+    __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+    __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+    __m128 c[4][4] = {
+            {_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx), zero},
+            {_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+                    _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy), zero},
+            {_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+                    _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz), zero},
+            {px, py, pz, one},
+    };
+
+    for (int column = 0; column < 4; ++column) {
+        _MM_TRANSPOSE4_PS(c[column][0], c[column][1], c[column][2], c[column][3]);
+        for (int lane = 0; lane < 4; ++lane) _mm_storeu_ps(out[lane] + column * 4, c[column][lane]);
+    }
+}
+
+static void BuildModelsSSE2(float *out, size_t outStride, float const *trs, size_t trsStride, size_t count) {
+    float scratch[16];
+
+    for (size_t i = 0; i < count; i += 4) {
+        // lanes past the end repeat the last transform into scratch
+        float *outs[4];
+        float const *ins[4];
+        for (size_t lane = 0; lane < 4; ++lane) {
+            bool used = i + lane < count;
+            size_t at = used ? i + lane : count - 1;
+            outs[lane] = used ? (float *) ((char *) out + at * outStride) : scratch;
+            ins[lane] = (float const *) ((char const *) trs + at * trsStride);
+        }
+        BuildFour(outs, ins);
+    }
+}
+
+static void MultiplySSE2(float *out, size_t outStride, float const *left, float const *right, size_t rightStride, size_t count) {
+    __m128 l0 = _mm_loadu_ps(left), l1 = _mm_loadu_ps(left + 4), l2 = _mm_loadu_ps(left + 8), l3 = _mm_loadu_ps(left + 12);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto r = (float const *) ((char const *) right + i * rightStride);
+        auto m = (float *) ((char *) out + i * outStride);
+
+        __m128 columns[4];
+        for (int column = 0; column < 4; ++column) {
+            __m128 c = _mm_loadu_ps(r + column * 4);
+            __m128 sum = _mm_mul_ps(l0, _mm_shuffle_ps(c, c, 0x00));
+            sum = _mm_add_ps(sum, _mm_mul_ps(l1, _mm_shuffle_ps(c, c, 0x55)));
+            sum = _mm_add_ps(sum, _mm_mul_ps(l2, _mm_shuffle_ps(c, c, 0xAA)));
+            columns[column] = _mm_add_ps(sum, _mm_mul_ps(l3, _mm_shuffle_ps(c, c, 0xFF)));
+        }
+        for (int column = 0; column < 4; ++column) _mm_storeu_ps(m + column * 4, columns[column]);
+    }
+}
+
+static const MatrixKernels sse2Kernels = {"sse2", BuildModelsSSE2, MultiplySSE2};
+
+MatrixKernels const *SSE2MatrixKernels() {
+    return &sse2Kernels;
+}
+
+#else
+
+MatrixKernels const *SSE2MatrixKernels() {
+    return nullptr;
+}
+
+#endif
@@ -3,3 +3,9 @@
 //
 
 #include "Plane.h"
+
+Plane::Plane(glm::vec4 const &coefficients) {
+    float length = glm::length(glm::vec3(coefficients));
+    this->normal = glm::vec3(coefficients) / length;
+    this->distance = coefficients.w / length;
+}
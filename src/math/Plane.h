@@ -5,4 +5,22 @@
 #ifndef CUTLASS_PLANE_H
 #define CUTLASS_PLANE_H
 
+#include <common.h>
+
+/*
+ * the points where dot(normal, point) + distance is 0. points where it's positive are in front of the plane.
+ */
+struct Plane {
+    glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f);
+    float distance = 0.0f;
+
+    Plane() = default;
+    Plane(glm::vec3 const &normal, float distance) : normal(normal), distance(distance) {}
+    // (a, b, c, d) of ax + by + cz + d = 0, normalized
+    explicit Plane(glm::vec4 const &coefficients);
+
+    // signed, and in world units
+    float Distance(glm::vec3 const &point) const { return glm::dot(this->normal, point) + this->distance; }
+};
+
 #endif //CUTLASS_PLANE_H
@@ -3,3 +3,41 @@
 //
 
 #include "Ray.h"
+
+#include <algorithm>
+
+bool Ray::Intersects(Box const &box, float maxDistance, float &distance) const {
+    return IntersectSlabs(this->origin, 1.0f / this->direction, box, maxDistance, distance);
+}
+
+bool Ray::Intersects(Box const &box, float maxDistance, float &distance, glm::vec3 &normal) const {
+    glm::vec3 inverse = 1.0f / this->direction;
+    glm::vec3 t0 = (box.min - this->origin) * inverse;
+    glm::vec3 t1 = (box.max - this->origin) * inverse;
+
+    // the face it goes in through is on the slab it enters last
+    float enter = 0.0f;
+    float exit = maxDistance;
+    int enterAxis = -1;
+    for (int axis = 0; axis < 3; ++axis) {
+        float near = std::min(t0[axis], t1[axis]);
+        float far = std::max(t0[axis], t1[axis]);
+        if (near > enter) {
+            enter = near;
+            enterAxis = axis;
+        }
+        if (far < exit) exit = far;
+    }
+
+    if (enter > exit) return false;
+    distance = enter;
+
+    if (enterAxis < 0) {
+        normal = -glm::normalize(this->direction);
+    }
+    else {
+        normal = glm::vec3(0.0f);
+        normal[enterAxis] = this->direction[enterAxis] > 0.0f ? -1.0f : 1.0f;
+    }
+    return true;
+}
@@ -5,4 +5,50 @@
 #ifndef CUTLASS_RAY_H
 #define CUTLASS_RAY_H
 
+#include <common.h>
+#include "math/Box.h"
+
+#include <algorithm>
+
+/*
+ * a half line. direction doesn't have to be unit length, distances are in multiples of it.
+ */
+struct Ray {
+    glm::vec3 origin = glm::vec3(0.0f);
+    glm::vec3 direction = glm::vec3(0.0f, 0.0f, -1.0f);
+
+    Ray() = default;
+    Ray(glm::vec3 const &origin, glm::vec3 const &direction) : origin(origin), direction(direction) {}
+
+    glm::vec3 At(float distance) const { return this->origin + this->direction * distance; }
+
+    // where the ray enters the box, if that's before maxDistance. a ray starting inside enters at 0
+    bool Intersects(Box const &box, float maxDistance, float &distance) const;
+    // and the normal of the face it enters through. a ray starting inside gets one facing back along it
+    bool Intersects(Box const &box, float maxDistance, float &distance, glm::vec3 &normal) const;
+};
+
+/*
+ * Ray::Intersects with the inverse of the direction worked out already, for one ray against many boxes. a zero
+ * direction component gives infinities, which sort themselves out in min and max unless the origin is exactly on
+ * the slab, where 0 * inf is nan and the comparisons ignore it
+ */
+inline bool IntersectSlabs(glm::vec3 const &origin, glm::vec3 const &inverse, Box const &box, float maxDistance, float &distance) {
+    glm::vec3 t0 = (box.min - origin) * inverse;
+    glm::vec3 t1 = (box.max - origin) * inverse;
+
+    float enter = 0.0f;
+    float exit = maxDistance;
+    for (int axis = 0; axis < 3; ++axis) {
+        float near = std::min(t0[axis], t1[axis]);
+        float far = std::max(t0[axis], t1[axis]);
+        if (near > enter) enter = near;
+        if (far < exit) exit = far;
+    }
+
+    if (enter > exit) return false;
+    distance = enter;
+    return true;
+}
+
 #endif //CUTLASS_RAY_H
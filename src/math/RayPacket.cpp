@@ -0,0 +1,81 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "RayPacket.h"
+
+#include <glm/simd/platform.h>
+
+#include <algorithm>
+#include <cassert>
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#include <immintrin.h>
+#endif
+
+RayPacket::RayPacket() {
+    for (int axis = 0; axis < 3; ++axis) {
+        std::fill(this->origin[axis], this->origin[axis] + CUT_RAY_PACKET, 0.0f);
+        std::fill(this->inverse[axis], this->inverse[axis] + CUT_RAY_PACKET, 1.0f);
+    }
+    std::fill(this->maxDistance, this->maxDistance + CUT_RAY_PACKET, -1.0f);
+}
+
+void RayPacket::Set(uint32_t lane, Ray const &ray, float maxDistance) {
+    assert(lane < CUT_RAY_PACKET);
+    for (int axis = 0; axis < 3; ++axis) {
+        this->origin[axis][lane] = ray.origin[axis];
+        this->inverse[axis][lane] = 1.0f / ray.direction[axis];
+    }
+    this->maxDistance[lane] = maxDistance;
+}
+
+uint32_t RayPacket::Intersects(Box const &box) const {
+    /*
+     * the slab test of Ray::Intersects, a lane each: the ray is inside the box between where it has entered all three
+     * slabs and where it leaves the first one
+     */
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+    __m256 enter = _mm256_setzero_ps();
+    __m256 exit = _mm256_load_ps(this->maxDistance);
+    for (int axis = 0; axis < 3; ++axis) {
+        __m256 origin = _mm256_load_ps(this->origin[axis]);
+        __m256 inverse = _mm256_load_ps(this->inverse[axis]);
+        __m256 t0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.min[axis]), origin), inverse);
+        __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.max[axis]), origin), inverse);
+        enter = _mm256_max_ps(_mm256_min_ps(t0, t1), enter);
+        exit = _mm256_min_ps(_mm256_max_ps(t0, t1), exit);
+    }
+    return (uint32_t) _mm256_movemask_ps(_mm256_cmp_ps(enter, exit, _CMP_LE_OQ));
+#elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+    uint32_t mask = 0;
+    for (int half = 0; half < CUT_RAY_PACKET; half += 4) {
+        __m128 enter = _mm_setzero_ps();
+        __m128 exit = _mm_load_ps(this->maxDistance + half);
+        for (int axis = 0; axis < 3; ++axis) {
+            __m128 origin = _mm_load_ps(this->origin[axis] + half);
+            __m128 inverse = _mm_load_ps(this->inverse[axis] + half);
+            __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.min[axis]), origin), inverse);
+            __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.max[axis]), origin), inverse);
+            enter = _mm_max_ps(_mm_min_ps(t0, t1), enter);
+            exit = _mm_min_ps(_mm_max_ps(t0, t1), exit);
+        }
+        mask |= (uint32_t) _mm_movemask_ps(_mm_cmple_ps(enter, exit)) << half;
+    }
+    return mask;
+#else
+    uint32_t mask = 0;
+    for (uint32_t lane = 0; lane < CUT_RAY_PACKET; ++lane) {
+        float enter = 0.0f;
+        float exit = this->maxDistance[lane];
+        for (int axis = 0; axis < 3; ++axis) {
+            float t0 = (box.min[axis] - this->origin[axis][lane]) * this->inverse[axis][lane];
+            float t1 = (box.max[axis] - this->origin[axis][lane]) * this->inverse[axis][lane];
+            enter = std::max(std::min(t0, t1), enter);
+            exit = std::min(std::max(t0, t1), exit);
+        }
+        mask |= (uint32_t) (enter <= exit) << lane;
+    }
+    return mask;
+#endif
+}
@@ -0,0 +1,48 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_RAYPACKET_H
+#define CUTLASS_RAYPACKET_H
+
+#include <common.h>
+#include "ecs/Entity.h"
+#include "math/Box.h"
+#include "math/Ray.h"
+
+#include <cstdint>
+
+// rays tested together. eight for avx, sse2 takes them in two halves
+#define CUT_RAY_PACKET 8
+
+/*
+ * the nearest thing a ray hit. entity is CUT_NULL_ENTITY when it hit nothing
+ */
+struct RayHit {
+    Entity entity = CUT_NULL_ENTITY;
+    float distance = 0.0f;
+    glm::vec3 normal = glm::vec3(0.0f);
+};
+
+/*
+ * up to CUT_RAY_PACKET rays laid out one array per axis, so a box can be tested against all of them at once.
+ * lanes that aren't in use have a negative maxDistance and never hit anything.
+ *
+ * a ray running exactly along one of a box's faces may or may not hit it, depending on how many lanes are tested
+ * together.
+ */
+struct alignas(32) RayPacket {
+    float origin[3][CUT_RAY_PACKET];
+    float inverse[3][CUT_RAY_PACKET];
+    // how far each lane still looks, traversal shortens it as closer hits turn up
+    float maxDistance[CUT_RAY_PACKET];
+
+    RayPacket();
+
+    void Set(uint32_t lane, Ray const &ray, float maxDistance);
+
+    // bit i set for each lane that enters the box within its maxDistance
+    uint32_t Intersects(Box const &box) const;
+};
+
+#endif //CUTLASS_RAYPACKET_H
@@ -3,26 +3,140 @@
 //
 
 #include "Transform.h"
+#include "MatrixKernels.h"
 
-Transform::Transform() : localScale(1.0f) {
+#include <cstddef>
+#include <glm/simd/platform.h>
 
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#include <immintrin.h>
+#endif
+
+Transform::Transform() : position(0.0f), rotation(1.0f, 0.0f, 0.0f, 0.0f), scale(1.0f), model(1.0f), dirty(false) {
+
+};
+
+void Transform::SetPosition(glm::vec3 const &position) {
+    this->position = position;
+    this->dirty = true;
+};
+
+void Transform::SetRotation(glm::quat const &rotation) {
+    this->rotation = glm::normalize(rotation);
+    this->dirty = true;
 };
 
-glm::mat4 Transform::LocalTransform() const {
-    glm::mat4 transform;
+void Transform::SetRotation(glm::vec3 const &degrees) {
+    this->rotation = glm::angleAxis(glm::radians(degrees.x), glm::vec3(1.0f, 0.0f, 0.0f))
+                   * glm::angleAxis(glm::radians(degrees.y), glm::vec3(0.0f, 1.0f, 0.0f))
+                   * glm::angleAxis(glm::radians(degrees.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    this->dirty = true;
+};
+
+void Transform::SetScale(glm::vec3 const &scale) {
+    this->scale = scale;
+    this->dirty = true;
+};
 
-    transform = glm::rotate(transform, glm::radians(this->localRotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-    transform = glm::rotate(transform, glm::radians(this->localRotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-    transform = glm::rotate(transform, glm::radians(this->localRotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-    transform = glm::scale(transform, this->localScale);
+glm::mat4 const &Transform::Model() const {
+    if (!this->dirty) return this->model;
 
-    return transform;
+    /*
+     * the rotation matrix of a unit quaternion with each column scaled, and the position as the last column. that's
+     * translate * rotate * scale without multiplying any matrices.
+     */
+    glm::quat const &q = this->rotation;
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    glm::mat4 &m = this->model;
+    m[0] = glm::vec4(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f) * this->scale.x;
+    m[1] = glm::vec4(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f) * this->scale.y;
+    m[2] = glm::vec4(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f) * this->scale.z;
+    m[3] = glm::vec4(this->position, 1.0f);
+
+    this->dirty = false;
+    return m;
 };
 
-glm::mat4 Transform::WorldTransform() const {
-    glm::mat4 transform;
+bool Transform::operator==(Transform const &other) const {
+    return this->position == other.position
+        && this->rotation == other.rotation
+        && this->scale == other.scale;
+};
 
-    transform = glm::translate(transform, this->worldPosition);
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+namespace {
+    // the dot of two quaternions in every lane, summed in the same order glm::dot sums them
+    inline __m128 Dot4(__m128 a, __m128 b) {
+        __m128 products = _mm_mul_ps(a, b);
+        __m128 pairs = _mm_add_ps(products, _mm_shuffle_ps(products, products, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+}
+#endif
 
-    return transform;
-};
\ No newline at end of file
+void MixTransforms(Transform *out, Transform const *from, Transform const *to, size_t count, float alpha) {
+    static_assert(offsetof(Transform, position) == 0 && offsetof(Transform, rotation) == 3 * sizeof(float)
+                  && offsetof(Transform, scale) == 7 * sizeof(float), "transforms are mixed as 10 floats");
+    size_t i = 0;
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    /*
+     * a transform is 10 floats: position.xyz, rotation.xyzw, scale.xyz. position and scale are mixed as the rows at 0
+     * and 6, which drag a rotation component each along, and the rotation is mixed as the row at 3 and stored last
+     * over the top of both. the sums are the scalar loop's, so a transform comes out the same whichever loop it
+     * went through.
+     */
+    __m128 const a4 = _mm_set1_ps(alpha);
+    __m128 const b4 = _mm_set1_ps(1.0f - alpha);
+    __m128 const one = _mm_set1_ps(1.0f);
+    __m128 const sign = _mm_set1_ps(-0.0f);
+    for (; i < count; ++i) {
+        float const *f = reinterpret_cast<float const *>(&from[i]);
+        float const *t = reinterpret_cast<float const *>(&to[i]);
+        float *o = reinterpret_cast<float *>(&out[i]);
+
+        __m128 fromLow = _mm_loadu_ps(f), toLow = _mm_loadu_ps(t);
+        __m128 fromHigh = _mm_loadu_ps(f + 6), toHigh = _mm_loadu_ps(t + 6);
+        __m128 fromRotation = _mm_loadu_ps(f + 3), toRotation = _mm_loadu_ps(t + 3);
+
+        // glm::mix is from + (to - from) * alpha
+        __m128 low = _mm_add_ps(fromLow, _mm_mul_ps(a4, _mm_sub_ps(toLow, fromLow)));
+        __m128 high = _mm_add_ps(fromHigh, _mm_mul_ps(a4, _mm_sub_ps(toHigh, fromHigh)));
+
+        // q and -q are the same rotation, the one closer to from is the short way
+        __m128 flip = _mm_and_ps(_mm_cmplt_ps(Dot4(fromRotation, toRotation), _mm_setzero_ps()), sign);
+        __m128 rotation = _mm_add_ps(_mm_mul_ps(fromRotation, b4), _mm_mul_ps(_mm_xor_ps(toRotation, flip), a4));
+        rotation = _mm_mul_ps(rotation, _mm_div_ps(one, _mm_sqrt_ps(Dot4(rotation, rotation))));
+
+        // the loads are all done before the stores, so out may alias from or to
+        _mm_storeu_ps(o, low);
+        _mm_storeu_ps(o + 6, high);
+        _mm_storeu_ps(o + 3, rotation);
+        out[i].dirty = true;
+    }
+#endif
+
+    for (; i < count; ++i) {
+        glm::quat rotation = to[i].rotation;
+        // q and -q are the same rotation, the one closer to from is the short way
+        if (glm::dot(from[i].rotation, rotation) < 0.0f) rotation = -rotation;
+
+        // normalized lerp, steps of a tick are small enough that it doesn't need to be a slerp
+        out[i].position = glm::mix(from[i].position, to[i].position, alpha);
+        out[i].rotation = glm::normalize(from[i].rotation * (1.0f - alpha) + rotation * alpha);
+        out[i].scale = glm::mix(from[i].scale, to[i].scale, alpha);
+        out[i].dirty = true;
+    }
+};
+
+void BuildModelMatrices(glm::mat4 *out, size_t outStride, Transform const *transforms, size_t count) {
+    static_assert(offsetof(Transform, position) == 0 && offsetof(Transform, rotation) == 3 * sizeof(float)
+                  && offsetof(Transform, scale) == 7 * sizeof(float), "the kernels read a transform as 10 floats");
+    if (!count) return;
+
+    GetMatrixKernels().buildModels(glm::value_ptr(*out), outStride, reinterpret_cast<float const *>(transforms),
+                                   sizeof(Transform), count);
+};
@@ -6,16 +6,57 @@
 #define CUTLASS_TRANSFORM_H
 
 #include <common.h>
+#include <glm/gtc/quaternion.hpp>
 
+/*
+ * position, rotation and scale, and the model matrix they make. the matrix is kept and only rebuilt by the first
+ * Model() after a setter changed something, so a transform that doesn't move costs nothing per frame.
+ *
+ * a dirty transform builds its matrix in Model(), which writes to it, so don't call that on a shared transform
+ * from more than one thread before it's been built once.
+ */
 class Transform {
 public:
-    glm::vec3 worldPosition;
-    glm::vec3 localRotation;
-    glm::vec3 localScale;
-
     Transform();
-    glm::mat4 LocalTransform() const;
-    glm::mat4 WorldTransform() const;
+
+    glm::vec3 const &Position() const { return this->position; }
+    glm::quat const &Rotation() const { return this->rotation; }
+    glm::vec3 const &Scale() const { return this->scale; }
+
+    void SetPosition(glm::vec3 const &position);
+    void SetRotation(glm::quat const &rotation);
+    // degrees, applied x, then y, then z
+    void SetRotation(glm::vec3 const &degrees);
+    void SetScale(glm::vec3 const &scale);
+
+    // translate * rotate * scale
+    glm::mat4 const &Model() const;
+
+    bool operator==(Transform const &other) const;
+    bool operator!=(Transform const &other) const { return !(*this == other); }
+
+private:
+    glm::vec3 position;
+    glm::quat rotation;
+    glm::vec3 scale;
+
+    mutable glm::mat4 model;
+    mutable bool dirty;
+
+    friend void MixTransforms(Transform *out, Transform const *from, Transform const *to, size_t count, float alpha);
+    friend void BuildModelMatrices(glm::mat4 *out, size_t outStride, Transform const *transforms, size_t count);
 };
 
-#endif //CUTLASS_GAMEOBJECT_H
\ No newline at end of file
+/*
+ * interpolates a run of transforms. rotations take the shorter way round, and the matrices are rebuilt on demand.
+ * out may alias from or to.
+ */
+void MixTransforms(Transform *out, Transform const *from, Transform const *to, size_t count, float alpha);
+
+/*
+ * Model() for a run of transforms at once with the widest matrix kernels the CPU has, see MatrixKernels. out is
+ * written every outStride bytes and the transforms' own matrices are left alone.
+ */
+void BuildModelMatrices(glm::mat4 *out, size_t outStride, Transform const *transforms, size_t count);
+
+#endif //CUTLASS_TRANSFORM_H
@@ -0,0 +1,193 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+#include <cassert>
+
+HierarchyNode TransformHierarchy::Add(Transform const &local, HierarchyNode parent) {
+    HierarchyNode node;
+    if (!this->freeNodes.empty()) {
+        node = this->freeNodes.back();
+        this->freeNodes.pop_back();
+    }
+    else {
+        node = (HierarchyNode) this->indices.size();
+        this->indices.push_back(CUT_NO_NODE);
+    }
+
+    // the parent is already in, so appending keeps it in front
+    auto index = (uint32_t) this->parents.size();
+    this->indices[node] = index;
+    this->parents.push_back(parent == CUT_NO_NODE ? -1 : (int32_t) this->indices[parent]);
+    this->locals.push_back(local);
+    this->worlds.emplace_back(1.0f);
+    this->dirty.push_back(0);
+    this->nodes.push_back(node);
+
+    this->MarkDirty(index);
+    return node;
+}
+
+void TransformHierarchy::Remove(HierarchyNode node) {
+    assert(this->Contains(node));
+    if (this->unsorted) this->Sort();
+
+    /*
+     * everything under the node comes after it, and anything whose parent is going goes too. survivors are packed
+     * down in the same pass, which keeps them in order.
+     */
+    uint32_t first = this->indices[node];
+    std::vector<int32_t> moved(this->parents.size() - first);
+    uint32_t kept = first;
+
+    for (auto i = first; i < this->parents.size(); ++i) {
+        int32_t parent = this->parents[i];
+        if (parent >= (int32_t) first) parent = moved[parent - first];
+
+        if (i == first || parent == -2) {
+            moved[i - first] = -2;
+            this->indices[this->nodes[i]] = CUT_NO_NODE;
+            this->freeNodes.push_back(this->nodes[i]);
+            continue;
+        }
+
+        moved[i - first] = (int32_t) kept;
+        this->parents[kept] = parent;
+        this->locals[kept] = this->locals[i];
+        this->worlds[kept] = this->worlds[i];
+        this->dirty[kept] = this->dirty[i];
+        this->nodes[kept] = this->nodes[i];
+        this->indices[this->nodes[kept]] = kept;
+        ++kept;
+    }
+
+    this->parents.resize(kept);
+    this->locals.resize(kept);
+    this->worlds.resize(kept);
+    this->dirty.resize(kept);
+    this->nodes.resize(kept);
+    this->firstDirty = std::min(this->firstDirty, first);
+}
+
+bool TransformHierarchy::Contains(HierarchyNode node) const {
+    return node < this->indices.size() && this->indices[node] != CUT_NO_NODE;
+}
+
+HierarchyNode TransformHierarchy::Parent(HierarchyNode node) const {
+    int32_t parent = this->parents[this->indices[node]];
+    return parent < 0 ? CUT_NO_NODE : this->nodes[parent];
+}
+
+void TransformHierarchy::SetParent(HierarchyNode node, HierarchyNode parent) {
+    uint32_t index = this->indices[node];
+
+    int32_t parentIndex = -1;
+    if (parent != CUT_NO_NODE) {
+        parentIndex = (int32_t) this->indices[parent];
+        for (int32_t above = parentIndex; above >= 0; above = this->parents[above]) {
+            assert(above != (int32_t) index && "a node can't be parented under itself");
+        }
+    }
+
+    this->parents[index] = parentIndex;
+    if (parentIndex > (int32_t) index) this->unsorted = true;
+    this->MarkDirty(index);
+}
+
+void TransformHierarchy::SetLocal(HierarchyNode node, Transform const &local) {
+    uint32_t index = this->indices[node];
+    this->locals[index] = local;
+    this->MarkDirty(index);
+}
+
+void TransformHierarchy::MarkDirty(uint32_t index) {
+    this->dirty[index] = 1;
+    this->firstDirty = std::min(this->firstDirty, index);
+}
+
+void TransformHierarchy::Update() {
+    if (this->unsorted) this->Sort();
+
+    auto count = (uint32_t) this->parents.size();
+    int32_t const *parents = this->parents.data();
+    uint8_t *dirty = this->dirty.data();
+    glm::mat4 *worlds = this->worlds.data();
+
+    // a node is dirty when it changed or its parent is, the parent was already visited
+    for (uint32_t i = this->firstDirty; i < count; ++i) {
+        int32_t parent = parents[i];
+        if (parent >= 0) dirty[i] |= dirty[parent];
+        if (!dirty[i]) continue;
+
+        worlds[i] = parent < 0 ? this->locals[i].Model() : worlds[parent] * this->locals[i].Model();
+    }
+
+    if (this->firstDirty < count) std::fill(this->dirty.begin() + this->firstDirty, this->dirty.end(), 0);
+    this->firstDirty = count;
+}
+
+/*
+ * puts parents back in front of their children: nodes are ordered by depth, and otherwise keep their order
+ */
+void TransformHierarchy::Sort() {
+    size_t count = this->parents.size();
+
+    std::vector<int32_t> depths(count, -1);
+    std::vector<uint32_t> chain;
+    int32_t maxDepth = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        // walk up to the first node with a known depth, then fill them in on the way back down
+        int32_t at = (int32_t) i;
+        while (at >= 0 && depths[at] < 0) {
+            chain.push_back((uint32_t) at);
+            at = this->parents[at];
+        }
+        int32_t depth = at < 0 ? -1 : depths[at];
+        while (!chain.empty()) {
+            depths[chain.back()] = ++depth;
+            chain.pop_back();
+        }
+        maxDepth = std::max(maxDepth, depths[i]);
+    }
+
+    // counting sort, which is stable
+    std::vector<uint32_t> starts(maxDepth + 2, 0);
+    for (int32_t depth : depths) ++starts[depth + 1];
+    for (size_t d = 1; d < starts.size(); ++d) starts[d] += starts[d - 1];
+
+    std::vector<uint32_t> order(count);
+    std::vector<int32_t> moved(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t to = starts[depths[i]]++;
+        order[to] = i;
+        moved[i] = (int32_t) to;
+    }
+
+    std::vector<int32_t> parents(count);
+    std::vector<Transform> locals(count);
+    std::vector<glm::mat4> worlds(count);
+    std::vector<uint8_t> dirty(count);
+    std::vector<HierarchyNode> nodes(count);
+    this->firstDirty = (uint32_t) count;
+
+    for (uint32_t to = 0; to < count; ++to) {
+        uint32_t from = order[to];
+        parents[to] = this->parents[from] < 0 ? -1 : moved[this->parents[from]];
+        locals[to] = this->locals[from];
+        worlds[to] = this->worlds[from];
+        dirty[to] = this->dirty[from];
+        nodes[to] = this->nodes[from];
+        this->indices[nodes[to]] = to;
+        if (dirty[to]) this->firstDirty = std::min(this->firstDirty, to);
+    }
+
+    this->parents.swap(parents);
+    this->locals.swap(locals);
+    this->worlds.swap(worlds);
+    this->dirty.swap(dirty);
+    this->nodes.swap(nodes);
+    this->unsorted = false;
+}
@@ -0,0 +1,75 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_TRANSFORMHIERARCHY_H
+#define CUTLASS_TRANSFORMHIERARCHY_H
+
+#include "math/Transform.h"
+
+#include <cstdint>
+
+#define CUT_NO_NODE 0xFFFFFFFF
+
+typedef uint32_t HierarchyNode;
+
+/*
+ * transforms parented to other transforms, e.g. props riding a platform. stored flat: each node's parent is an index
+ * into the same arrays, and parents always come before their children. that makes Update() one pass from front to
+ * back, where every parent's world matrix is done by the time its children need it.
+ *
+ *     HierarchyNode platform = hierarchy.Add(platformTransform);
+ *     HierarchyNode crate = hierarchy.Add(crateTransform, platform);   // relative to the platform
+ *     ...
+ *     hierarchy.SetLocal(platform, moved);
+ *     hierarchy.Update();                                              // the platform and everything on it
+ *     hierarchy.World(crate);
+ *
+ * Update() starts at the first node that changed and only builds matrices for changed nodes and whatever is under
+ * them. nodes are moved around when reparenting or removing, so they're referred to by handle. a removed node's
+ * handle may be handed out again.
+ */
+class TransformHierarchy {
+public:
+    // parent is CUT_NO_NODE for a root
+    HierarchyNode Add(Transform const &local, HierarchyNode parent = CUT_NO_NODE);
+    // removes the node and everything under it
+    void Remove(HierarchyNode node);
+
+    bool Contains(HierarchyNode node) const;
+    size_t Count() const { return this->parents.size(); }
+
+    HierarchyNode Parent(HierarchyNode node) const;
+    // keeps the node's local transform, so it moves with its new parent. a node can't go under itself
+    void SetParent(HierarchyNode node, HierarchyNode parent);
+
+    Transform const &Local(HierarchyNode node) const { return this->locals[this->indices[node]]; }
+    void SetLocal(HierarchyNode node, Transform const &local);
+
+    // as of the last Update()
+    glm::mat4 const &World(HierarchyNode node) const { return this->worlds[this->indices[node]]; }
+
+    void Update();
+
+private:
+    // parallel arrays, in parent before child order. parents[i] is -1 for a root and below i otherwise
+    std::vector<int32_t> parents;
+    std::vector<Transform> locals;
+    std::vector<glm::mat4> worlds;
+    std::vector<uint8_t> dirty;
+    std::vector<HierarchyNode> nodes;
+
+    // handle to index, CUT_NO_NODE for free handles
+    std::vector<uint32_t> indices;
+    std::vector<HierarchyNode> freeNodes;
+
+    // nothing before this index is dirty
+    uint32_t firstDirty = 0;
+    // a reparent put a child before its parent
+    bool unsorted = false;
+
+    void MarkDirty(uint32_t index);
+    void Sort();
+};
+
+#endif //CUTLASS_TRANSFORMHIERARCHY_H
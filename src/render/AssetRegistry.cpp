@@ -0,0 +1,140 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "AssetRegistry.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <mutex>
+
+static Mesh meshes[CUT_MAX_MESHES];
+static Box meshBounds[CUT_MAX_MESHES];
+static uint64_t meshHashes[CUT_MAX_MESHES];
+static Material materials[CUT_MAX_MATERIALS];
+static uint32_t materialPrograms[CUT_MAX_MATERIALS];
+static GLuint programs[CUT_MAX_PROGRAMS];
+static std::atomic<uint32_t> meshCount(0);
+static std::atomic<uint32_t> materialCount(0);
+static uint32_t programCount = 0;
+static std::mutex registryMutex;
+
+static uint64_t HashBytes(uint64_t hash, void const *data, size_t size) {
+    // FNV-1a
+    uint8_t const *bytes = static_cast<uint8_t const *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint64_t HashMesh(Mesh const &mesh) {
+    uint64_t hash = HashBytes(14695981039346656037ull, mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex));
+    return HashBytes(hash, mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int));
+}
+
+/*
+ * every GameObject carries its own copy of its mesh, so meshes are compared by content; the hash rules out all but
+ * the real match.
+ */
+static bool SameMesh(Mesh const &a, uint64_t aHash, Mesh const &b, uint64_t bHash) {
+    return aHash == bHash
+        && a.vertices.size() == b.vertices.size() && a.indices.size() == b.indices.size()
+        && !std::memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(Vertex))
+        && !std::memcmp(a.indices.data(), b.indices.data(), a.indices.size() * sizeof(unsigned int));
+}
+
+static bool SameMaterial(Material const &a, Material const &b) {
+    if (a.shader.GetID() != b.shader.GetID()) return false;
+    if (a.instancedShader.GetID() != b.instancedShader.GetID()) return false;
+    if (a.blend != b.blend) return false;
+    if (a.tint != b.tint) return false;
+    for (int i = 0; i < CUT_MATERIAL_TEXTURES; ++i) {
+        if (a.texture[i].ID != b.texture[i].ID) return false;
+    }
+    return true;
+}
+
+MeshHandle RegisterMesh(Mesh const &mesh) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    uint32_t count = meshCount.load(std::memory_order_relaxed);
+    uint64_t hash = HashMesh(mesh);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (SameMesh(meshes[i], meshHashes[i], mesh, hash)) return i;
+    }
+
+    if (count == CUT_MAX_MESHES) {
+        std::cout << "Ran out of mesh handles" << std::endl;
+        throw CUT_ERROR_ASSET_LIMIT;
+    }
+
+    // the slot is filled in before the count lets readers see it
+    meshes[count] = mesh;
+    meshHashes[count] = hash;
+    meshBounds[count] = Box();
+    for (Vertex const &vertex : mesh.vertices) meshBounds[count].Expand(vertex.position);
+    meshCount.store(count + 1, std::memory_order_release);
+
+    return count;
+}
+
+MaterialHandle RegisterMaterial(Material const &material) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    uint32_t count = materialCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (SameMaterial(materials[i], material)) return i;
+    }
+
+    if (count == CUT_MAX_MATERIALS) {
+        std::cout << "Ran out of material handles" << std::endl;
+        throw CUT_ERROR_ASSET_LIMIT;
+    }
+
+    uint32_t program = 0;
+    while (program < programCount && programs[program] != material.shader.GetID()) ++program;
+    if (program == programCount) {
+        if (programCount == CUT_MAX_PROGRAMS) {
+            std::cout << "Ran out of program indices" << std::endl;
+            throw CUT_ERROR_ASSET_LIMIT;
+        }
+        programs[programCount++] = material.shader.GetID();
+    }
+
+    materials[count] = material;
+    materialPrograms[count] = program;
+    materialCount.store(count + 1, std::memory_order_release);
+
+    return count;
+}
+
+Mesh const &GetMesh(MeshHandle handle) {
+    assert(handle < meshCount.load(std::memory_order_acquire));
+    return meshes[handle];
+}
+
+Box const &GetMeshBounds(MeshHandle handle) {
+    assert(handle < meshCount.load(std::memory_order_acquire));
+    return meshBounds[handle];
+}
+
+Material const &GetMaterial(MaterialHandle handle) {
+    assert(handle < materialCount.load(std::memory_order_acquire));
+    return materials[handle];
+}
+
+uint32_t GetMeshCount() {
+    return meshCount.load(std::memory_order_acquire);
+}
+
+uint32_t GetMaterialCount() {
+    return materialCount.load(std::memory_order_acquire);
+}
+
+uint32_t GetProgramIndex(MaterialHandle handle) {
+    assert(handle < materialCount.load(std::memory_order_acquire));
+    return materialPrograms[handle];
+}
@@ -0,0 +1,40 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_ASSETREGISTRY_H
+#define CUTLASS_ASSETREGISTRY_H
+
+#include "math/Box.h"
+#include "render/Mesh.h"
+
+#include <cstdint>
+
+#define CUT_MAX_MESHES 4096
+#define CUT_MAX_MATERIALS 4096
+#define CUT_MAX_PROGRAMS 256
+
+typedef uint32_t MeshHandle;
+typedef uint32_t MaterialHandle;
+
+/*
+ * meshes and materials are registered once and referred to by handle from then on, so entities and render
+ * snapshots can carry them around for the price of an int. registering something that's already registered (same
+ * vertices and indices, or same program and textures) hands back the existing handle.
+ *
+ * registering can happen on any thread, lookups are lock free and can run alongside it.
+ */
+MeshHandle RegisterMesh(Mesh const &mesh);
+MaterialHandle RegisterMaterial(Material const &material);
+
+Mesh const &GetMesh(MeshHandle handle);
+// around the mesh's vertices, empty when the mesh was registered without them
+Box const &GetMeshBounds(MeshHandle handle);
+uint32_t GetMeshCount();
+Material const &GetMaterial(MaterialHandle handle);
+uint32_t GetMaterialCount();
+
+// small dense index of the material's shader program, shared by every material using the same program
+uint32_t GetProgramIndex(MaterialHandle handle);
+
+#endif //CUTLASS_ASSETREGISTRY_H
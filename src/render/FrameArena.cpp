@@ -0,0 +1,49 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+FrameArena::FrameArena(size_t capacity)
+        : memory(new unsigned char[capacity]),
+          capacity(capacity),
+          used(0),
+          overflowBytes(0) {
+
+}
+
+void FrameArena::Reset() {
+
+    /*
+     * last frame didn't fit, so grow to fit all of it in one block from now on
+     */
+    if (!this->overflow.empty()) {
+        this->capacity += this->overflowBytes;
+        this->memory.reset(new unsigned char[this->capacity]);
+        this->overflow.clear();
+        this->overflowBytes = 0;
+    }
+
+    this->used = 0;
+}
+
+void *FrameArena::Allocate(size_t bytes, size_t alignment) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(this->memory.get());
+    size_t offset = ((base + this->used + alignment - 1) & ~(uintptr_t) (alignment - 1)) - base;
+
+    if (offset + bytes <= this->capacity) {
+        this->used = offset + bytes;
+        return this->memory.get() + offset;
+    }
+
+    // doesn't fit this frame, hand out a block of its own and remember to grow
+    size_t size = bytes + alignment;
+    this->overflow.emplace_back(new unsigned char[size]);
+    this->overflowBytes += size;
+
+    uintptr_t block = reinterpret_cast<uintptr_t>(this->overflow.back().get());
+    return reinterpret_cast<void *>((block + alignment - 1) & ~(uintptr_t) (alignment - 1));
+}
@@ -0,0 +1,47 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_FRAMEARENA_H
+#define CUTLASS_FRAMEARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/*
+ * bump allocator for data that only lives for one frame. everything is handed back at once by Reset(), and once
+ * the arena has grown to fit a frame it stops allocating altogether.
+ *
+ * only meant for trivially destructible types; nothing allocated here ever has its destructor run.
+ */
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity = 64 * 1024);
+
+    FrameArena(FrameArena const &) = delete;
+    FrameArena &operator=(FrameArena const &) = delete;
+
+    // frees everything allocated since the last reset
+    void Reset();
+
+    void *Allocate(size_t bytes, size_t alignment);
+
+    template<class T>
+    T *Allocate(size_t count) {
+        return static_cast<T *>(this->Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    size_t Used() const { return this->used; }
+
+private:
+    std::unique_ptr<unsigned char[]> memory;
+    size_t capacity;
+    size_t used;
+
+    // blocks that had to be allocated because the frame didn't fit, folded into one on the next reset
+    std::vector<std::unique_ptr<unsigned char[]>> overflow;
+    size_t overflowBytes;
+};
+
+#endif //CUTLASS_FRAMEARENA_H
@@ -0,0 +1,1381 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "GLCapture.h"
+
+#include <cstdio>
+
+GLCapture glCapture;
+
+/*
+ * every call the capture swaps out. queries (glGet*, glGetString, glCheckFramebufferStatus, ...) aren't in here,
+ * they don't change anything a replay needs, and glFinish is left to whoever replays.
+ */
+#define CUT_CAPTURED_CALLS(X) \
+    X(GenBuffers) X(DeleteBuffers) X(GenVertexArrays) X(DeleteVertexArrays) X(GenTextures) X(DeleteTextures) \
+    X(GenFramebuffers) X(DeleteFramebuffers) X(GenRenderbuffers) X(DeleteRenderbuffers) X(GenSamplers) \
+    X(DeleteSamplers) \
+    X(CreateShader) X(DeleteShader) X(ShaderSource) X(CompileShader) X(CreateProgram) X(DeleteProgram) \
+    X(AttachShader) X(LinkProgram) X(GetUniformLocation) X(UniformBlockBinding) \
+    X(UseProgram) X(BindVertexArray) X(BindBuffer) X(BindBufferRange) X(BindTexture) X(BindSampler) \
+    X(ActiveTexture) X(BindFramebuffer) X(BindRenderbuffer) \
+    X(BufferData) X(BufferSubData) X(BufferStorage) X(MapBufferRange) X(FlushMappedBufferRange) X(UnmapBuffer) \
+    X(CopyBufferSubData) X(TexImage2D) X(TexParameteri) X(GenerateMipmap) X(PixelStorei) \
+    X(RenderbufferStorage) X(FramebufferRenderbuffer) \
+    X(VertexAttribPointer) X(EnableVertexAttribArray) X(DisableVertexAttribArray) X(VertexAttribDivisor) \
+    X(Uniform1i) X(Uniform1f) X(Uniform2fv) X(Uniform3fv) X(Uniform4fv) \
+    X(UniformMatrix2fv) X(UniformMatrix3fv) X(UniformMatrix4fv) \
+    X(ProgramUniform1i) X(ProgramUniform1f) X(ProgramUniform2fv) X(ProgramUniform3fv) X(ProgramUniform4fv) \
+    X(ProgramUniformMatrix2fv) X(ProgramUniformMatrix3fv) X(ProgramUniformMatrix4fv) \
+    X(Enable) X(Disable) X(BlendFunc) X(DepthMask) X(DepthFunc) X(CullFace) X(Viewport) X(ClearColor) X(Clear) \
+    X(DrawArrays) X(DrawElements) X(DrawElementsBaseVertex) X(DrawElementsInstanced) \
+    X(DrawElementsInstancedBaseVertex) X(DrawElementsInstancedBaseVertexBaseInstance) X(MultiDrawElementsIndirect) \
+    X(FenceSync) X(ClientWaitSync) X(DeleteSync)
+
+// one byte in front of every call in the stream
+enum CapturedCall : uint8_t {
+#define CUT_CALL_ID(name) CUT_GL_##name,
+    CUT_CAPTURED_CALLS(CUT_CALL_ID)
+#undef CUT_CALL_ID
+};
+
+// stands in for a payload pointer that was null
+static constexpr uint32_t CUT_NO_PAYLOAD = 0xFFFFFFFF;
+
+static constexpr uint32_t CUT_CAPTURE_MAGIC = 0x50414343; // "CCAP"
+static constexpr uint32_t CUT_CAPTURE_VERSION = 1;
+
+// the functions the hooks pass calls on to
+#define CUT_REAL_POINTER(name) static decltype(glad_gl##name) real##name = nullptr;
+CUT_CAPTURED_CALLS(CUT_REAL_POINTER)
+#undef CUT_REAL_POINTER
+
+static uint64_t HashPayload(uint8_t const *memory, uint64_t size) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (uint64_t i = 0; i < size; ++i) {
+        hash ^= memory[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// bytes glTexImage2D reads for an image, the way GL steps through rows
+static uint64_t ImageBytes(GLsizei width, GLsizei height, GLenum format, GLenum type, GLint alignment) {
+    uint64_t components;
+    switch (format) {
+        case GL_RG:
+        case GL_RG_INTEGER: components = 2; break;
+        case GL_RGB:
+        case GL_BGR:
+        case GL_RGB_INTEGER: components = 3; break;
+        case GL_RGBA:
+        case GL_BGRA:
+        case GL_RGBA_INTEGER: components = 4; break;
+        default: components = 1; break;
+    }
+
+    uint64_t pixel;
+    switch (type) {
+        case GL_UNSIGNED_BYTE:
+        case GL_BYTE: pixel = components; break;
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:
+        case GL_HALF_FLOAT: pixel = components * 2; break;
+        case GL_UNSIGNED_INT:
+        case GL_INT:
+        case GL_FLOAT: pixel = components * 4; break;
+        // packed types hold the whole pixel
+        case GL_UNSIGNED_SHORT_5_6_5:
+        case GL_UNSIGNED_SHORT_4_4_4_4:
+        case GL_UNSIGNED_SHORT_5_5_5_1: pixel = 2; break;
+        default: pixel = 4; break;
+    }
+
+    if (width <= 0 || height <= 0) return 0;
+    uint64_t row = pixel * width;
+    uint64_t stride = (row + alignment - 1) / alignment * alignment;
+    return stride * (height - 1) + row;
+}
+
+void GLCapture::Call(uint8_t id) {
+    this->data.stream.push_back(id);
+    ++this->stats.calls;
+}
+
+uint32_t GLCapture::Payload(void const *memory, uint64_t size) {
+    if (!memory) return CUT_NO_PAYLOAD;
+
+    auto bytes = (uint8_t const *) memory;
+    uint64_t hash = HashPayload(bytes, size);
+
+    // the same vertices, texture or uniform values sent again are only stored once
+    auto found = this->payloadIndex.find(hash);
+    if (found != this->payloadIndex.end()) {
+        GLCapturePayload const &stored = this->data.payloads[found->second];
+        // the hash only narrows it down, the bytes have to match too
+        if (stored.size == size && (!size || !std::memcmp(this->data.blob.data() + stored.offset, bytes, size))) return found->second;
+    }
+
+    GLCapturePayload payload;
+    payload.hash = hash;
+    payload.offset = this->data.blob.size();
+    payload.size = size;
+    this->data.blob.insert(this->data.blob.end(), bytes, bytes + size);
+
+    auto index = (uint32_t) this->data.payloads.size();
+    this->data.payloads.push_back(payload);
+    this->payloadIndex[hash] = index;
+    return index;
+}
+
+void GLCapture::BeginFrame() {
+    this->stats = GLCaptureStats();
+    this->inFrame = true;
+
+    GLCaptureFrame frame;
+    frame.begin = frame.end = this->data.stream.size();
+    this->data.frames.push_back(frame);
+}
+
+GLCaptureStats GLCapture::EndFrame() {
+    if (this->inFrame) {
+        this->data.frames.back().end = this->data.stream.size();
+        this->frames.push_back(this->stats);
+        this->inFrame = false;
+    }
+    return this->stats;
+}
+
+/*
+ * the functions glad points at while the capture is installed. each one passes the call on and writes it down, in
+ * the same order GLReplay::Run reads it back.
+ */
+struct GLCaptureHooks {
+    using Generator = void (APIENTRYP)(GLsizei, GLuint *);
+    using Deleter = void (APIENTRYP)(GLsizei, GLuint const *);
+
+    static void Generate(uint8_t id, Generator real, GLsizei count, GLuint *names) {
+        real(count, names);
+        glCapture.Call(id);
+        glCapture.Put(count);
+        for (GLsizei i = 0; i < count; ++i) glCapture.Put(names[i]);
+    }
+
+    static void Delete(uint8_t id, Deleter real, GLsizei count, GLuint const *names) {
+        glCapture.Call(id);
+        glCapture.Put(count);
+        for (GLsizei i = 0; i < count; ++i) glCapture.Put(names[i]);
+        real(count, names);
+    }
+
+#define CUT_OBJECT_HOOKS(plural) \
+    static void APIENTRY Gen##plural(GLsizei count, GLuint *names) { Generate(CUT_GL_Gen##plural, realGen##plural, count, names); } \
+    static void APIENTRY Delete##plural(GLsizei count, GLuint const *names) { Delete(CUT_GL_Delete##plural, realDelete##plural, count, names); }
+
+    CUT_OBJECT_HOOKS(Buffers)
+    CUT_OBJECT_HOOKS(VertexArrays)
+    CUT_OBJECT_HOOKS(Textures)
+    CUT_OBJECT_HOOKS(Framebuffers)
+    CUT_OBJECT_HOOKS(Renderbuffers)
+    CUT_OBJECT_HOOKS(Samplers)
+#undef CUT_OBJECT_HOOKS
+
+    /*
+     * shaders and programs
+     */
+    static GLuint APIENTRY CreateShader(GLenum type) {
+        GLuint shader = realCreateShader(type);
+        glCapture.Call(CUT_GL_CreateShader);
+        glCapture.Put(type);
+        glCapture.Put(shader);
+        return shader;
+    }
+
+    static void APIENTRY DeleteShader(GLuint shader) {
+        glCapture.Call(CUT_GL_DeleteShader);
+        glCapture.Put(shader);
+        realDeleteShader(shader);
+    }
+
+    static void APIENTRY ShaderSource(GLuint shader, GLsizei count, GLchar const *const *strings, GLint const *lengths) {
+        // kept as one string, it compiles the same
+        std::string source;
+        for (GLsizei i = 0; i < count; ++i) {
+            if (lengths && lengths[i] >= 0) source.append(strings[i], (size_t) lengths[i]);
+            else source.append(strings[i]);
+        }
+
+        glCapture.Call(CUT_GL_ShaderSource);
+        glCapture.Put(shader);
+        glCapture.Put(glCapture.Payload(source.data(), source.size()));
+        realShaderSource(shader, count, strings, lengths);
+    }
+
+    static void APIENTRY CompileShader(GLuint shader) {
+        glCapture.Call(CUT_GL_CompileShader);
+        glCapture.Put(shader);
+        realCompileShader(shader);
+    }
+
+    static GLuint APIENTRY CreateProgram() {
+        GLuint program = realCreateProgram();
+        glCapture.Call(CUT_GL_CreateProgram);
+        glCapture.Put(program);
+        return program;
+    }
+
+    static void APIENTRY DeleteProgram(GLuint program) {
+        glCapture.Call(CUT_GL_DeleteProgram);
+        glCapture.Put(program);
+        realDeleteProgram(program);
+    }
+
+    static void APIENTRY AttachShader(GLuint program, GLuint shader) {
+        glCapture.Call(CUT_GL_AttachShader);
+        glCapture.Put(program);
+        glCapture.Put(shader);
+        realAttachShader(program, shader);
+    }
+
+    static void APIENTRY LinkProgram(GLuint program) {
+        glCapture.Call(CUT_GL_LinkProgram);
+        glCapture.Put(program);
+        realLinkProgram(program);
+    }
+
+    // the replay asks for the location again by name, another driver may hand out different ones
+    static GLint APIENTRY GetUniformLocation(GLuint program, GLchar const *name) {
+        GLint location = realGetUniformLocation(program, name);
+        glCapture.Call(CUT_GL_GetUniformLocation);
+        glCapture.Put(program);
+        glCapture.Put(glCapture.Payload(name, std::strlen(name) + 1));
+        glCapture.Put(location);
+        return location;
+    }
+
+    // same for block indices, which are only known by name
+    static void APIENTRY UniformBlockBinding(GLuint program, GLuint index, GLuint binding) {
+        char name[256] = {};
+        glGetActiveUniformBlockName(program, index, sizeof(name), nullptr, name);
+
+        glCapture.Call(CUT_GL_UniformBlockBinding);
+        glCapture.Put(program);
+        glCapture.Put(binding);
+        glCapture.Put(glCapture.Payload(name, std::strlen(name) + 1));
+        realUniformBlockBinding(program, index, binding);
+    }
+
+    /*
+     * binds
+     */
+    static void APIENTRY UseProgram(GLuint program) {
+        glCapture.Call(CUT_GL_UseProgram);
+        ++glCapture.stats.binds;
+        glCapture.Put(program);
+        realUseProgram(program);
+    }
+
+    static void APIENTRY BindVertexArray(GLuint vertexArray) {
+        glCapture.Call(CUT_GL_BindVertexArray);
+        ++glCapture.stats.binds;
+        glCapture.Put(vertexArray);
+        realBindVertexArray(vertexArray);
+    }
+
+    static void APIENTRY BindBuffer(GLenum target, GLuint buffer) {
+        glCapture.Call(CUT_GL_BindBuffer);
+        ++glCapture.stats.binds;
+        glCapture.Put(target);
+        glCapture.Put(buffer);
+        realBindBuffer(target, buffer);
+    }
+
+    static void APIENTRY BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+        glCapture.Call(CUT_GL_BindBufferRange);
+        ++glCapture.stats.binds;
+        glCapture.Put(target);
+        glCapture.Put(index);
+        glCapture.Put(buffer);
+        glCapture.Put((int64_t) offset);
+        glCapture.Put((int64_t) size);
+        realBindBufferRange(target, index, buffer, offset, size);
+    }
+
+    static void APIENTRY BindTexture(GLenum target, GLuint texture) {
+        glCapture.Call(CUT_GL_BindTexture);
+        ++glCapture.stats.binds;
+        glCapture.Put(target);
+        glCapture.Put(texture);
+        realBindTexture(target, texture);
+    }
+
+    static void APIENTRY BindSampler(GLuint unit, GLuint sampler) {
+        glCapture.Call(CUT_GL_BindSampler);
+        ++glCapture.stats.binds;
+        glCapture.Put(unit);
+        glCapture.Put(sampler);
+        realBindSampler(unit, sampler);
+    }
+
+    static void APIENTRY ActiveTexture(GLenum unit) {
+        glCapture.Call(CUT_GL_ActiveTexture);
+        ++glCapture.stats.stateChanges;
+        glCapture.Put(unit);
+        realActiveTexture(unit);
+    }
+
+    static void APIENTRY BindFramebuffer(GLenum target, GLuint framebuffer) {
+        glCapture.Call(CUT_GL_BindFramebuffer);
+        ++glCapture.stats.binds;
+        glCapture.Put(target);
+        glCapture.Put(framebuffer);
+        realBindFramebuffer(target, framebuffer);
+    }
+
+    static void APIENTRY BindRenderbuffer(GLenum target, GLuint renderbuffer) {
+        glCapture.Call(CUT_GL_BindRenderbuffer);
+        ++glCapture.stats.binds;
+        glCapture.Put(target);
+        glCapture.Put(renderbuffer);
+        realBindRenderbuffer(target, renderbuffer);
+    }
+
+    /*
+     * buffer and texture data
+     */
+    static void Uploaded(uint64_t bytes) {
+        ++glCapture.stats.bufferUploads;
+        glCapture.stats.bytesUploaded += bytes;
+    }
+
+    static void APIENTRY BufferData(GLenum target, GLsizeiptr size, void const *data, GLenum usage) {
+        glCapture.Call(CUT_GL_BufferData);
+        if (data) Uploaded((uint64_t) size);
+        glCapture.Put(target);
+        glCapture.Put((int64_t) size);
+        glCapture.Put(glCapture.Payload(data, (uint64_t) size));
+        glCapture.Put(usage);
+        realBufferData(target, size, data, usage);
+    }
+
+    static void APIENTRY BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, void const *data) {
+        glCapture.Call(CUT_GL_BufferSubData);
+        Uploaded((uint64_t) size);
+        glCapture.Put(target);
+        glCapture.Put((int64_t) offset);
+        glCapture.Put(glCapture.Payload(data, (uint64_t) size));
+        realBufferSubData(target, offset, size, data);
+    }
+
+    static void APIENTRY BufferStorage(GLenum target, GLsizeiptr size, void const *data, GLbitfield flags) {
+        glCapture.Call(CUT_GL_BufferStorage);
+        if (data) Uploaded((uint64_t) size);
+        glCapture.Put(target);
+        glCapture.Put((int64_t) size);
+        glCapture.Put(glCapture.Payload(data, (uint64_t) size));
+        glCapture.Put(flags);
+        realBufferStorage(target, size, data, flags);
+    }
+
+    static void *APIENTRY MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+        void *memory = realMapBufferRange(target, offset, length, access);
+        glCapture.Call(CUT_GL_MapBufferRange);
+        glCapture.Put(target);
+        glCapture.Put((int64_t) offset);
+        glCapture.Put((int64_t) length);
+        glCapture.Put(access);
+
+        if ((access & GL_MAP_PERSISTENT_BIT) && (access & GL_MAP_WRITE_BIT)) {
+            std::cout << "GL capture can't see writes to a persistent mapping, the replay won't have them" << std::endl;
+        }
+        glCapture.mappings[target] = {(uint8_t *) memory, length, access};
+        return memory;
+    }
+
+    // the written range goes into the stream here, it's the only point we know it's done
+    static void APIENTRY FlushMappedBufferRange(GLenum target, GLintptr offset, GLsizeiptr length) {
+        GLCapture::Mapping const &mapping = glCapture.mappings[target];
+        glCapture.Call(CUT_GL_FlushMappedBufferRange);
+        Uploaded((uint64_t) length);
+        glCapture.Put(target);
+        glCapture.Put((int64_t) offset);
+        glCapture.Put(glCapture.Payload(mapping.memory ? mapping.memory + offset : nullptr, (uint64_t) length));
+        realFlushMappedBufferRange(target, offset, length);
+    }
+
+    // without explicit flushes, unmapping is what makes the whole range visible
+    static GLboolean APIENTRY UnmapBuffer(GLenum target) {
+        GLCapture::Mapping mapping = glCapture.mappings[target];
+        glCapture.mappings.erase(target);
+
+        bool written = (mapping.access & GL_MAP_WRITE_BIT) && !(mapping.access & GL_MAP_FLUSH_EXPLICIT_BIT);
+        glCapture.Call(CUT_GL_UnmapBuffer);
+        if (written) Uploaded((uint64_t) mapping.length);
+        glCapture.Put(target);
+        glCapture.Put(written ? glCapture.Payload(mapping.memory, (uint64_t) mapping.length) : CUT_NO_PAYLOAD);
+        return realUnmapBuffer(target);
+    }
+
+    static void APIENTRY CopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size) {
+        glCapture.Call(CUT_GL_CopyBufferSubData);
+        glCapture.Put(readTarget);
+        glCapture.Put(writeTarget);
+        glCapture.Put((int64_t) readOffset);
+        glCapture.Put((int64_t) writeOffset);
+        glCapture.Put((int64_t) size);
+        realCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size);
+    }
+
+    static void APIENTRY TexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border,
+                                    GLenum format, GLenum type, void const *pixels) {
+        uint64_t bytes = ImageBytes(width, height, format, type, glCapture.unpackAlignment);
+        glCapture.Call(CUT_GL_TexImage2D);
+        if (pixels) Uploaded(bytes);
+        glCapture.Put(target);
+        glCapture.Put(level);
+        glCapture.Put(internalFormat);
+        glCapture.Put(width);
+        glCapture.Put(height);
+        glCapture.Put(border);
+        glCapture.Put(format);
+        glCapture.Put(type);
+        glCapture.Put(glCapture.Payload(pixels, bytes));
+        realTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+    }
+
+    static void APIENTRY TexParameteri(GLenum target, GLenum name, GLint value) {
+        glCapture.Call(CUT_GL_TexParameteri);
+        glCapture.Put(target);
+        glCapture.Put(name);
+        glCapture.Put(value);
+        realTexParameteri(target, name, value);
+    }
+
+    static void APIENTRY GenerateMipmap(GLenum target) {
+        glCapture.Call(CUT_GL_GenerateMipmap);
+        glCapture.Put(target);
+        realGenerateMipmap(target);
+    }
+
+    static void APIENTRY PixelStorei(GLenum name, GLint value) {
+        if (name == GL_UNPACK_ALIGNMENT) glCapture.unpackAlignment = value;
+        glCapture.Call(CUT_GL_PixelStorei);
+        glCapture.Put(name);
+        glCapture.Put(value);
+        realPixelStorei(name, value);
+    }
+
+    static void APIENTRY RenderbufferStorage(GLenum target, GLenum internalFormat, GLsizei width, GLsizei height) {
+        glCapture.Call(CUT_GL_RenderbufferStorage);
+        glCapture.Put(target);
+        glCapture.Put(internalFormat);
+        glCapture.Put(width);
+        glCapture.Put(height);
+        realRenderbufferStorage(target, internalFormat, width, height);
+    }
+
+    static void APIENTRY FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbufferTarget, GLuint renderbuffer) {
+        glCapture.Call(CUT_GL_FramebufferRenderbuffer);
+        glCapture.Put(target);
+        glCapture.Put(attachment);
+        glCapture.Put(renderbufferTarget);
+        glCapture.Put(renderbuffer);
+        realFramebufferRenderbuffer(target, attachment, renderbufferTarget, renderbuffer);
+    }
+
+    /*
+     * vertex layout
+     */
+    static void APIENTRY VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, void const *pointer) {
+        glCapture.Call(CUT_GL_VertexAttribPointer);
+        glCapture.Put(index);
+        glCapture.Put(size);
+        glCapture.Put(type);
+        glCapture.Put(normalized);
+        glCapture.Put(stride);
+        // an offset into the bound buffer
+        glCapture.Put((uint64_t) (uintptr_t) pointer);
+        realVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    }
+
+    static void APIENTRY EnableVertexAttribArray(GLuint index) {
+        glCapture.Call(CUT_GL_EnableVertexAttribArray);
+        glCapture.Put(index);
+        realEnableVertexAttribArray(index);
+    }
+
+    static void APIENTRY DisableVertexAttribArray(GLuint index) {
+        glCapture.Call(CUT_GL_DisableVertexAttribArray);
+        glCapture.Put(index);
+        realDisableVertexAttribArray(index);
+    }
+
+    static void APIENTRY VertexAttribDivisor(GLuint index, GLuint divisor) {
+        glCapture.Call(CUT_GL_VertexAttribDivisor);
+        glCapture.Put(index);
+        glCapture.Put(divisor);
+        realVertexAttribDivisor(index, divisor);
+    }
+
+    /*
+     * uniforms. arrays are payloads like any other upload
+     */
+    static void Uniform(uint8_t id, GLuint program, GLint location, GLsizei count, GLboolean transpose, GLfloat const *value, int floats) {
+        uint64_t bytes = (uint64_t) count * floats * sizeof(GLfloat);
+        glCapture.Call(id);
+        ++glCapture.stats.uniformUploads;
+        glCapture.stats.bytesUploaded += bytes;
+        glCapture.Put(program);
+        glCapture.Put(location);
+        glCapture.Put(count);
+        glCapture.Put(transpose);
+        glCapture.Put(glCapture.Payload(value, bytes));
+    }
+
+    static void APIENTRY Uniform1i(GLint location, GLint value) {
+        glCapture.Call(CUT_GL_Uniform1i);
+        ++glCapture.stats.uniformUploads;
+        glCapture.Put(location);
+        glCapture.Put(value);
+        realUniform1i(location, value);
+    }
+
+    static void APIENTRY Uniform1f(GLint location, GLfloat value) {
+        glCapture.Call(CUT_GL_Uniform1f);
+        ++glCapture.stats.uniformUploads;
+        glCapture.Put(location);
+        glCapture.Put(value);
+        realUniform1f(location, value);
+    }
+
+    static void APIENTRY ProgramUniform1i(GLuint program, GLint location, GLint value) {
+        glCapture.Call(CUT_GL_ProgramUniform1i);
+        ++glCapture.stats.uniformUploads;
+        glCapture.Put(program);
+        glCapture.Put(location);
+        glCapture.Put(value);
+        realProgramUniform1i(program, location, value);
+    }
+
+    static void APIENTRY ProgramUniform1f(GLuint program, GLint location, GLfloat value) {
+        glCapture.Call(CUT_GL_ProgramUniform1f);
+        ++glCapture.stats.uniformUploads;
+        glCapture.Put(program);
+        glCapture.Put(location);
+        glCapture.Put(value);
+        realProgramUniform1f(program, location, value);
+    }
+
+#define CUT_UNIFORM_HOOKS(suffix, floats) \
+    static void APIENTRY Uniform##suffix(GLint location, GLsizei count, GLfloat const *value) { \
+        Uniform(CUT_GL_Uniform##suffix, 0, location, count, GL_FALSE, value, floats); \
+        realUniform##suffix(location, count, value); \
+    } \
+    static void APIENTRY ProgramUniform##suffix(GLuint program, GLint location, GLsizei count, GLfloat const *value) { \
+        Uniform(CUT_GL_ProgramUniform##suffix, program, location, count, GL_FALSE, value, floats); \
+        realProgramUniform##suffix(program, location, count, value); \
+    }
+
+#define CUT_UNIFORM_MATRIX_HOOKS(suffix, floats) \
+    static void APIENTRY Uniform##suffix(GLint location, GLsizei count, GLboolean transpose, GLfloat const *value) { \
+        Uniform(CUT_GL_Uniform##suffix, 0, location, count, transpose, value, floats); \
+        realUniform##suffix(location, count, transpose, value); \
+    } \
+    static void APIENTRY ProgramUniform##suffix(GLuint program, GLint location, GLsizei count, GLboolean transpose, GLfloat const *value) { \
+        Uniform(CUT_GL_ProgramUniform##suffix, program, location, count, transpose, value, floats); \
+        realProgramUniform##suffix(program, location, count, transpose, value); \
+    }
+
+    CUT_UNIFORM_HOOKS(2fv, 2)
+    CUT_UNIFORM_HOOKS(3fv, 3)
+    CUT_UNIFORM_HOOKS(4fv, 4)
+    CUT_UNIFORM_MATRIX_HOOKS(Matrix2fv, 4)
+    CUT_UNIFORM_MATRIX_HOOKS(Matrix3fv, 9)
+    CUT_UNIFORM_MATRIX_HOOKS(Matrix4fv, 16)
+#undef CUT_UNIFORM_HOOKS
+#undef CUT_UNIFORM_MATRIX_HOOKS
+
+    /*
+     * fixed function state
+     */
+    static void APIENTRY Enable(GLenum capability) {
+        glCapture.Call(CUT_GL_Enable);
+        ++glCapture.stats.stateChanges;
+        glCapture.Put(capability);
+        realEnable(capability);
+    }
+
+    static void APIENTRY Disable(GLenum capability) {
+        glCapture.Call(CUT_GL_Disable);
+        ++glCapture.stats.stateChanges;
+        glCapture.Put(capability);
+        realDisable(capability);
+    }
+
+    static void APIENTRY BlendFunc(GLenum source, GLenum destination) {
+        glCapture.Call(CUT_GL_BlendFunc);
+        ++glCapture.stats.stateChanges;
+        glCapture.Put(source);
+        glCapture.Put(destination);
+        realBlendFunc(source, destination);
+    }
+
+    static void APIENTRY DepthMask(GLboolean write) {
+        glCapture.Call(CUT_GL_DepthMask);
+        ++glCapture.stats.stateChanges;
+        glCapture.Put(write);
+        realDepthMask(write);
+    }
+
+    static void APIENTRY DepthFunc(GLenum func) {
+        glCapture.Call(CUT_GL_DepthFunc);
+        ++glCapture.stats.stateChanges;
+        glCapture.Put(func);
+        realDepthFunc(func);
+    }
+
+    static void APIENTRY CullFace(GLenum face) {
+        glCapture.Call(CUT_GL_CullFace);
+        ++glCapture.stats.stateChanges;
+        glCapture.Put(face);
+        realCullFace(face);
+    }
+
+    static void APIENTRY Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+        glCapture.Call(CUT_GL_Viewport);
+        ++glCapture.stats.stateChanges;
+        glCapture.Put(x);
+        glCapture.Put(y);
+        glCapture.Put(width);
+        glCapture.Put(height);
+        realViewport(x, y, width, height);
+    }
+
+    static void APIENTRY ClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+        glCapture.Call(CUT_GL_ClearColor);
+        ++glCapture.stats.stateChanges;
+        glCapture.Put(glm::vec4(red, green, blue, alpha));
+        realClearColor(red, green, blue, alpha);
+    }
+
+    static void APIENTRY Clear(GLbitfield mask) {
+        glCapture.Call(CUT_GL_Clear);
+        glCapture.Put(mask);
+        realClear(mask);
+    }
+
+    /*
+     * draws. index and indirect pointers are offsets into the bound buffers
+     */
+    static void APIENTRY DrawArrays(GLenum mode, GLint first, GLsizei count) {
+        glCapture.Call(CUT_GL_DrawArrays);
+        ++glCapture.stats.draws;
+        glCapture.Put(mode);
+        glCapture.Put(first);
+        glCapture.Put(count);
+        realDrawArrays(mode, first, count);
+    }
+
+    static void Elements(uint8_t id, GLenum mode, GLsizei count, GLenum type, void const *indices, GLsizei instances, GLint baseVertex,
+                         GLuint baseInstance) {
+        glCapture.Call(id);
+        ++glCapture.stats.draws;
+        glCapture.Put(mode);
+        glCapture.Put(count);
+        glCapture.Put(type);
+        glCapture.Put((uint64_t) (uintptr_t) indices);
+        glCapture.Put(instances);
+        glCapture.Put(baseVertex);
+        glCapture.Put(baseInstance);
+    }
+
+    static void APIENTRY DrawElements(GLenum mode, GLsizei count, GLenum type, void const *indices) {
+        Elements(CUT_GL_DrawElements, mode, count, type, indices, 1, 0, 0);
+        realDrawElements(mode, count, type, indices);
+    }
+
+    static void APIENTRY DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, void const *indices, GLint baseVertex) {
+        Elements(CUT_GL_DrawElementsBaseVertex, mode, count, type, indices, 1, baseVertex, 0);
+        realDrawElementsBaseVertex(mode, count, type, indices, baseVertex);
+    }
+
+    static void APIENTRY DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, void const *indices, GLsizei instances) {
+        Elements(CUT_GL_DrawElementsInstanced, mode, count, type, indices, instances, 0, 0);
+        realDrawElementsInstanced(mode, count, type, indices, instances);
+    }
+
+    static void APIENTRY DrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, void const *indices, GLsizei instances,
+                                                         GLint baseVertex) {
+        Elements(CUT_GL_DrawElementsInstancedBaseVertex, mode, count, type, indices, instances, baseVertex, 0);
+        realDrawElementsInstancedBaseVertex(mode, count, type, indices, instances, baseVertex);
+    }
+
+    static void APIENTRY DrawElementsInstancedBaseVertexBaseInstance(GLenum mode, GLsizei count, GLenum type, void const *indices,
+                                                                     GLsizei instances, GLint baseVertex, GLuint baseInstance) {
+        Elements(CUT_GL_DrawElementsInstancedBaseVertexBaseInstance, mode, count, type, indices, instances, baseVertex, baseInstance);
+        realDrawElementsInstancedBaseVertexBaseInstance(mode, count, type, indices, instances, baseVertex, baseInstance);
+    }
+
+    static void APIENTRY MultiDrawElementsIndirect(GLenum mode, GLenum type, void const *indirect, GLsizei drawCount, GLsizei stride) {
+        glCapture.Call(CUT_GL_MultiDrawElementsIndirect);
+        ++glCapture.stats.draws;
+        glCapture.stats.indirectDraws += (uint32_t) drawCount;
+        glCapture.Put(mode);
+        glCapture.Put(type);
+        glCapture.Put((uint64_t) (uintptr_t) indirect);
+        glCapture.Put(drawCount);
+        glCapture.Put(stride);
+        realMultiDrawElementsIndirect(mode, type, indirect, drawCount, stride);
+    }
+
+    /*
+     * fences
+     */
+    static GLsync APIENTRY FenceSync(GLenum condition, GLbitfield flags) {
+        GLsync sync = realFenceSync(condition, flags);
+        glCapture.Call(CUT_GL_FenceSync);
+        glCapture.Put(condition);
+        glCapture.Put(flags);
+        glCapture.Put((uint64_t) (uintptr_t) sync);
+        return sync;
+    }
+
+    // only the wait that got through is kept, how often it timed out before that depends on the machine
+    static GLenum APIENTRY ClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+        GLenum result = realClientWaitSync(sync, flags, timeout);
+        if (result == GL_TIMEOUT_EXPIRED) return result;
+
+        glCapture.Call(CUT_GL_ClientWaitSync);
+        glCapture.Put((uint64_t) (uintptr_t) sync);
+        glCapture.Put(flags);
+        return result;
+    }
+
+    static void APIENTRY DeleteSync(GLsync sync) {
+        glCapture.Call(CUT_GL_DeleteSync);
+        glCapture.Put((uint64_t) (uintptr_t) sync);
+        realDeleteSync(sync);
+    }
+};
+
+void GLCapture::Install() {
+    if (this->installed) return;
+    this->installed = true;
+
+    // functions the context doesn't have stay null, so the engine's version checks still see them missing
+#define CUT_INSTALL_HOOK(name) \
+    real##name = glad_gl##name; \
+    if (real##name) glad_gl##name = GLCaptureHooks::name;
+    CUT_CAPTURED_CALLS(CUT_INSTALL_HOOK)
+#undef CUT_INSTALL_HOOK
+}
+
+void GLCapture::Uninstall() {
+    if (!this->installed) return;
+    this->installed = false;
+
+#define CUT_UNINSTALL_HOOK(name) \
+    if (real##name) glad_gl##name = real##name;
+    CUT_CAPTURED_CALLS(CUT_UNINSTALL_HOOK)
+#undef CUT_UNINSTALL_HOOK
+}
+
+/*
+ * capture files: a small header, then the stream, the frames, the payload table and the payload bytes, each one
+ * preceded by its length
+ */
+template<class T>
+static bool WriteArray(FILE *file, std::vector<T> const &array) {
+    uint64_t count = array.size();
+    return fwrite(&count, sizeof(count), 1, file) == 1 && fwrite(array.data(), sizeof(T), array.size(), file) == array.size();
+}
+
+template<class T>
+static bool ReadArray(FILE *file, std::vector<T> &array, uint64_t &remaining) {
+    uint64_t count = 0;
+    if (remaining < sizeof(count) || fread(&count, sizeof(count), 1, file) != 1) return false;
+    remaining -= sizeof(count);
+    // a damaged length mustn't allocate more than the file could hold
+    if (count > remaining / sizeof(T)) return false;
+    remaining -= count * sizeof(T);
+    array.resize((size_t) count);
+    return fread(array.data(), sizeof(T), array.size(), file) == array.size();
+}
+
+bool GLCaptureData::Save(const char *path) const {
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+
+    uint32_t header[2] = {CUT_CAPTURE_MAGIC, CUT_CAPTURE_VERSION};
+    bool written = fwrite(header, sizeof(header), 1, file) == 1 && WriteArray(file, this->stream) && WriteArray(file, this->frames) &&
+                   WriteArray(file, this->payloads) && WriteArray(file, this->blob);
+    return fclose(file) == 0 && written;
+}
+
+bool GLCaptureData::Load(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return false;
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint64_t remaining = length > 0 ? (uint64_t) length : 0;
+
+    uint32_t header[2] = {};
+    bool read = remaining >= sizeof(header) && fread(header, sizeof(header), 1, file) == 1 && header[0] == CUT_CAPTURE_MAGIC &&
+                header[1] == CUT_CAPTURE_VERSION && (remaining -= sizeof(header), true) && ReadArray(file, this->stream, remaining) &&
+                ReadArray(file, this->frames, remaining) && ReadArray(file, this->payloads, remaining) && ReadArray(file, this->blob, remaining);
+    fclose(file);
+    if (!read) return false;
+
+    /*
+     * the replay trusts the tables, so a damaged file is turned away here instead of being read out of bounds later.
+     * the stream itself is checked as it's read, see GLReplay::Need.
+     */
+    for (GLCaptureFrame const &frame : this->frames) {
+        if (frame.begin > frame.end || frame.end > this->stream.size()) return false;
+    }
+    if (this->payloads.size() >= CUT_NO_PAYLOAD) return false;
+    for (GLCapturePayload const &payload : this->payloads) {
+        if (payload.offset > this->blob.size() || payload.size > this->blob.size() - payload.offset) return false;
+    }
+    return true;
+}
+
+bool GLReplay::Load(const char *path) {
+    return this->data.Load(path);
+}
+
+void GLReplay::Load(GLCaptureData const &capture) {
+    this->data = capture;
+}
+
+/*
+ * the range mapped from the buffer bound to target, null when there isn't one. asked of GL rather than remembered from
+ * the map call, the buffer bound there may have changed or been respecified since.
+ */
+static uint8_t *MappedRange(GLenum target, uint64_t &length) {
+    GLint mapped = GL_FALSE;
+    glGetBufferParameteriv(target, GL_BUFFER_MAPPED, &mapped);
+    length = 0;
+    if (!mapped) return nullptr;
+
+    void *memory = nullptr;
+    GLint64 size = 0;
+    glGetBufferPointerv(target, GL_BUFFER_MAP_POINTER, &memory);
+    glGetBufferParameteri64v(target, GL_BUFFER_MAP_LENGTH, &size);
+    length = size > 0 ? (uint64_t) size : 0;
+    return (uint8_t *) memory;
+}
+
+void GLReplay::Need(size_t bytes) const {
+    if (bytes > this->end - this->cursor) {
+        std::cout << "GL capture ends in the middle of a call" << std::endl;
+        throw CUT_ERROR_BAD_CAPTURE;
+    }
+}
+
+uint8_t const *GLReplay::Payload(uint32_t index, uint64_t size) const {
+    if (index == CUT_NO_PAYLOAD) return nullptr;
+    if (index >= this->data.payloads.size() || this->data.payloads[index].size < size) {
+        std::cout << "GL capture refers to payload " << index << ", which is missing or too small" << std::endl;
+        throw CUT_ERROR_BAD_CAPTURE;
+    }
+    return this->data.blob.data() + this->data.payloads[index].offset;
+}
+
+uint64_t GLReplay::PayloadSize(uint32_t index) const {
+    return this->Payload(index) ? this->data.payloads[index].size : 0;
+}
+
+GLchar const *GLReplay::String(uint32_t index) const {
+    auto string = (GLchar const *) this->Payload(index, 1);
+    if (!string || string[this->data.payloads[index].size - 1]) {
+        std::cout << "GL capture has a name that isn't a string" << std::endl;
+        throw CUT_ERROR_BAD_CAPTURE;
+    }
+    return string;
+}
+
+GLuint GLReplay::Name(NameKind kind, GLuint captured) {
+    if (!captured) return 0;
+
+    auto found = this->names[kind].find(captured);
+    if (found != this->names[kind].end()) return found->second;
+
+    if (kind == CUT_NAME_FRAMEBUFFER) return this->defaultFramebuffer;
+    ++this->unknownNames;
+    return 0;
+}
+
+void GLReplay::Created(NameKind kind, GLuint captured, GLuint live) {
+    this->names[kind][captured] = live;
+}
+
+GLint GLReplay::Location(GLint captured) {
+    if (captured < 0) return captured;
+
+    auto found = this->locations.find((uint64_t) this->program << 32 | (uint32_t) captured);
+    return found != this->locations.end() ? found->second : -1;
+}
+
+void GLReplay::Setup() {
+    size_t end = this->data.frames.empty() ? this->data.stream.size() : (size_t) this->data.frames.front().begin;
+    this->Run(0, end);
+}
+
+void GLReplay::ReplayFrame(size_t frame) {
+    GLCaptureFrame const &range = this->data.frames[frame];
+    this->Run((size_t) range.begin, (size_t) range.end);
+}
+
+/*
+ * reads calls back in exactly the order GLCaptureHooks wrote them
+ */
+void GLReplay::Run(size_t begin, size_t end) {
+    this->cursor = begin;
+    this->end = end;
+
+    auto generate = [this](NameKind kind, void (APIENTRYP gen)(GLsizei, GLuint *)) {
+        auto count = this->Get<GLsizei>();
+        // the names follow the count, so a damaged count runs past the end
+        this->Need(count >= 0 ? (size_t) count * sizeof(GLuint) : SIZE_MAX);
+        std::vector<GLuint> live((size_t) count);
+        gen(count, live.data());
+        for (GLsizei i = 0; i < count; ++i) this->Created(kind, this->Get<GLuint>(), live[i]);
+    };
+
+    auto remove = [this](NameKind kind, void (APIENTRYP del)(GLsizei, GLuint const *)) {
+        auto count = this->Get<GLsizei>();
+        // the names follow the count, so a damaged count runs past the end
+        this->Need(count >= 0 ? (size_t) count * sizeof(GLuint) : SIZE_MAX);
+        std::vector<GLuint> live((size_t) count);
+        for (GLsizei i = 0; i < count; ++i) {
+            GLuint captured = this->Get<GLuint>();
+            live[i] = this->Name(kind, captured);
+            this->names[kind].erase(captured);
+        }
+        del(count, live.data());
+    };
+
+    while (this->cursor < end) {
+        auto call = (CapturedCall) this->Get<uint8_t>();
+        switch (call) {
+            case CUT_GL_GenBuffers: generate(CUT_NAME_BUFFER, glGenBuffers); break;
+            case CUT_GL_DeleteBuffers: remove(CUT_NAME_BUFFER, glDeleteBuffers); break;
+            case CUT_GL_GenVertexArrays: generate(CUT_NAME_VERTEX_ARRAY, glGenVertexArrays); break;
+            case CUT_GL_DeleteVertexArrays: remove(CUT_NAME_VERTEX_ARRAY, glDeleteVertexArrays); break;
+            case CUT_GL_GenTextures: generate(CUT_NAME_TEXTURE, glGenTextures); break;
+            case CUT_GL_DeleteTextures: remove(CUT_NAME_TEXTURE, glDeleteTextures); break;
+            case CUT_GL_GenFramebuffers: generate(CUT_NAME_FRAMEBUFFER, glGenFramebuffers); break;
+            case CUT_GL_DeleteFramebuffers: remove(CUT_NAME_FRAMEBUFFER, glDeleteFramebuffers); break;
+            case CUT_GL_GenRenderbuffers: generate(CUT_NAME_RENDERBUFFER, glGenRenderbuffers); break;
+            case CUT_GL_DeleteRenderbuffers: remove(CUT_NAME_RENDERBUFFER, glDeleteRenderbuffers); break;
+            case CUT_GL_GenSamplers: generate(CUT_NAME_SAMPLER, glGenSamplers); break;
+            case CUT_GL_DeleteSamplers: remove(CUT_NAME_SAMPLER, glDeleteSamplers); break;
+
+            case CUT_GL_CreateShader: {
+                auto type = this->Get<GLenum>();
+                auto captured = this->Get<GLuint>();
+                this->Created(CUT_NAME_SHADER, captured, glCreateShader(type));
+                break;
+            }
+            case CUT_GL_DeleteShader: {
+                auto captured = this->Get<GLuint>();
+                glDeleteShader(this->Name(CUT_NAME_SHADER, captured));
+                this->names[CUT_NAME_SHADER].erase(captured);
+                break;
+            }
+            case CUT_GL_ShaderSource: {
+                GLuint shader = this->Name(CUT_NAME_SHADER, this->Get<GLuint>());
+                auto index = this->Get<uint32_t>();
+                auto length = (GLint) this->PayloadSize(index);
+                auto source = (GLchar const *) this->Payload(index);
+                if (source) glShaderSource(shader, 1, &source, &length);
+                break;
+            }
+            case CUT_GL_CompileShader: glCompileShader(this->Name(CUT_NAME_SHADER, this->Get<GLuint>())); break;
+            case CUT_GL_CreateProgram: this->Created(CUT_NAME_PROGRAM, this->Get<GLuint>(), glCreateProgram()); break;
+            case CUT_GL_DeleteProgram: {
+                auto captured = this->Get<GLuint>();
+                glDeleteProgram(this->Name(CUT_NAME_PROGRAM, captured));
+                this->names[CUT_NAME_PROGRAM].erase(captured);
+                break;
+            }
+            case CUT_GL_AttachShader: {
+                GLuint program = this->Name(CUT_NAME_PROGRAM, this->Get<GLuint>());
+                glAttachShader(program, this->Name(CUT_NAME_SHADER, this->Get<GLuint>()));
+                break;
+            }
+            case CUT_GL_LinkProgram: glLinkProgram(this->Name(CUT_NAME_PROGRAM, this->Get<GLuint>())); break;
+            case CUT_GL_GetUniformLocation: {
+                GLuint program = this->Name(CUT_NAME_PROGRAM, this->Get<GLuint>());
+                GLchar const *name = this->String(this->Get<uint32_t>());
+                auto captured = this->Get<GLint>();
+                if (captured >= 0) this->locations[(uint64_t) program << 32 | (uint32_t) captured] = glGetUniformLocation(program, name);
+                break;
+            }
+            case CUT_GL_UniformBlockBinding: {
+                GLuint program = this->Name(CUT_NAME_PROGRAM, this->Get<GLuint>());
+                auto binding = this->Get<GLuint>();
+                GLchar const *name = this->String(this->Get<uint32_t>());
+                GLuint index = glGetUniformBlockIndex(program, name);
+                if (index != GL_INVALID_INDEX) glUniformBlockBinding(program, index, binding);
+                break;
+            }
+
+            case CUT_GL_UseProgram:
+                this->program = this->Name(CUT_NAME_PROGRAM, this->Get<GLuint>());
+                glUseProgram(this->program);
+                break;
+            case CUT_GL_BindVertexArray: glBindVertexArray(this->Name(CUT_NAME_VERTEX_ARRAY, this->Get<GLuint>())); break;
+            case CUT_GL_BindBuffer: {
+                auto target = this->Get<GLenum>();
+                glBindBuffer(target, this->Name(CUT_NAME_BUFFER, this->Get<GLuint>()));
+                break;
+            }
+            case CUT_GL_BindBufferRange: {
+                auto target = this->Get<GLenum>();
+                auto index = this->Get<GLuint>();
+                GLuint buffer = this->Name(CUT_NAME_BUFFER, this->Get<GLuint>());
+                auto offset = (GLintptr) this->Get<int64_t>();
+                auto size = (GLsizeiptr) this->Get<int64_t>();
+                glBindBufferRange(target, index, buffer, offset, size);
+                break;
+            }
+            case CUT_GL_BindTexture: {
+                auto target = this->Get<GLenum>();
+                glBindTexture(target, this->Name(CUT_NAME_TEXTURE, this->Get<GLuint>()));
+                break;
+            }
+            case CUT_GL_BindSampler: {
+                auto unit = this->Get<GLuint>();
+                glBindSampler(unit, this->Name(CUT_NAME_SAMPLER, this->Get<GLuint>()));
+                break;
+            }
+            case CUT_GL_ActiveTexture: glActiveTexture(this->Get<GLenum>()); break;
+            case CUT_GL_BindFramebuffer: {
+                auto target = this->Get<GLenum>();
+                glBindFramebuffer(target, this->Name(CUT_NAME_FRAMEBUFFER, this->Get<GLuint>()));
+                break;
+            }
+            case CUT_GL_BindRenderbuffer: {
+                auto target = this->Get<GLenum>();
+                glBindRenderbuffer(target, this->Name(CUT_NAME_RENDERBUFFER, this->Get<GLuint>()));
+                break;
+            }
+
+            case CUT_GL_BufferData: {
+                auto target = this->Get<GLenum>();
+                auto size = (GLsizeiptr) this->Get<int64_t>();
+                uint8_t const *data = this->Payload(this->Get<uint32_t>(), (uint64_t) size);
+                glBufferData(target, size, data, this->Get<GLenum>());
+                break;
+            }
+            case CUT_GL_BufferSubData: {
+                auto target = this->Get<GLenum>();
+                auto offset = (GLintptr) this->Get<int64_t>();
+                auto index = this->Get<uint32_t>();
+                glBufferSubData(target, offset, (GLsizeiptr) this->PayloadSize(index), this->Payload(index));
+                break;
+            }
+            case CUT_GL_BufferStorage: {
+                auto target = this->Get<GLenum>();
+                auto size = (GLsizeiptr) this->Get<int64_t>();
+                uint8_t const *data = this->Payload(this->Get<uint32_t>(), (uint64_t) size);
+                glBufferStorage(target, size, data, this->Get<GLbitfield>());
+                break;
+            }
+            case CUT_GL_MapBufferRange: {
+                auto target = this->Get<GLenum>();
+                auto offset = (GLintptr) this->Get<int64_t>();
+                auto length = (GLsizeiptr) this->Get<int64_t>();
+                auto access = this->Get<GLbitfield>();
+                glMapBufferRange(target, offset, length, access);
+                break;
+            }
+            case CUT_GL_FlushMappedBufferRange: {
+                auto target = this->Get<GLenum>();
+                auto offset = (GLintptr) this->Get<int64_t>();
+                auto index = this->Get<uint32_t>();
+                auto length = (GLsizeiptr) this->PayloadSize(index);
+                uint64_t mapped;
+                uint8_t *memory = MappedRange(target, mapped);
+                if (memory && index != CUT_NO_PAYLOAD) {
+                    if (offset < 0 || (uint64_t) offset > mapped || (uint64_t) length > mapped - offset) {
+                        std::cout << "GL capture flushes outside its mapping" << std::endl;
+                        throw CUT_ERROR_BAD_CAPTURE;
+                    }
+                    std::memcpy(memory + offset, this->Payload(index), (size_t) length);
+                }
+                glFlushMappedBufferRange(target, offset, length);
+                break;
+            }
+            case CUT_GL_UnmapBuffer: {
+                auto target = this->Get<GLenum>();
+                auto index = this->Get<uint32_t>();
+                uint64_t mapped;
+                uint8_t *memory = MappedRange(target, mapped);
+                if (memory && index != CUT_NO_PAYLOAD) {
+                    uint64_t length = this->PayloadSize(index);
+                    if (length > mapped) {
+                        std::cout << "GL capture writes past its mapping" << std::endl;
+                        throw CUT_ERROR_BAD_CAPTURE;
+                    }
+                    std::memcpy(memory, this->Payload(index), (size_t) length);
+                }
+                glUnmapBuffer(target);
+                break;
+            }
+            case CUT_GL_CopyBufferSubData: {
+                auto readTarget = this->Get<GLenum>();
+                auto writeTarget = this->Get<GLenum>();
+                auto readOffset = (GLintptr) this->Get<int64_t>();
+                auto writeOffset = (GLintptr) this->Get<int64_t>();
+                glCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, (GLsizeiptr) this->Get<int64_t>());
+                break;
+            }
+            case CUT_GL_TexImage2D: {
+                auto target = this->Get<GLenum>();
+                auto level = this->Get<GLint>();
+                auto internalFormat = this->Get<GLint>();
+                auto width = this->Get<GLsizei>();
+                auto height = this->Get<GLsizei>();
+                auto border = this->Get<GLint>();
+                auto format = this->Get<GLenum>();
+                auto type = this->Get<GLenum>();
+                uint8_t const *pixels = this->Payload(this->Get<uint32_t>(), ImageBytes(width, height, format, type, this->unpackAlignment));
+                glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+                break;
+            }
+            case CUT_GL_TexParameteri: {
+                auto target = this->Get<GLenum>();
+                auto name = this->Get<GLenum>();
+                glTexParameteri(target, name, this->Get<GLint>());
+                break;
+            }
+            case CUT_GL_GenerateMipmap: glGenerateMipmap(this->Get<GLenum>()); break;
+            case CUT_GL_PixelStorei: {
+                auto name = this->Get<GLenum>();
+                auto value = this->Get<GLint>();
+                if (name == GL_UNPACK_ALIGNMENT && (value == 1 || value == 2 || value == 4 || value == 8)) this->unpackAlignment = value;
+                glPixelStorei(name, value);
+                break;
+            }
+            case CUT_GL_RenderbufferStorage: {
+                auto target = this->Get<GLenum>();
+                auto internalFormat = this->Get<GLenum>();
+                auto width = this->Get<GLsizei>();
+                glRenderbufferStorage(target, internalFormat, width, this->Get<GLsizei>());
+                break;
+            }
+            case CUT_GL_FramebufferRenderbuffer: {
+                auto target = this->Get<GLenum>();
+                auto attachment = this->Get<GLenum>();
+                auto renderbufferTarget = this->Get<GLenum>();
+                glFramebufferRenderbuffer(target, attachment, renderbufferTarget, this->Name(CUT_NAME_RENDERBUFFER, this->Get<GLuint>()));
+                break;
+            }
+
+            case CUT_GL_VertexAttribPointer: {
+                auto index = this->Get<GLuint>();
+                auto size = this->Get<GLint>();
+                auto type = this->Get<GLenum>();
+                auto normalized = this->Get<GLboolean>();
+                auto stride = this->Get<GLsizei>();
+                glVertexAttribPointer(index, size, type, normalized, stride, (void const *) (uintptr_t) this->Get<uint64_t>());
+                break;
+            }
+            case CUT_GL_EnableVertexAttribArray: glEnableVertexAttribArray(this->Get<GLuint>()); break;
+            case CUT_GL_DisableVertexAttribArray: glDisableVertexAttribArray(this->Get<GLuint>()); break;
+            case CUT_GL_VertexAttribDivisor: {
+                auto index = this->Get<GLuint>();
+                glVertexAttribDivisor(index, this->Get<GLuint>());
+                break;
+            }
+
+            case CUT_GL_Uniform1i: {
+                GLint location = this->Location(this->Get<GLint>());
+                glUniform1i(location, this->Get<GLint>());
+                break;
+            }
+            case CUT_GL_Uniform1f: {
+                GLint location = this->Location(this->Get<GLint>());
+                glUniform1f(location, this->Get<GLfloat>());
+                break;
+            }
+            case CUT_GL_ProgramUniform1i:
+            case CUT_GL_ProgramUniform1f: {
+                GLuint program = this->Name(CUT_NAME_PROGRAM, this->Get<GLuint>());
+                // locations are looked up against the program they belong to
+                GLuint current = this->program;
+                this->program = program;
+                GLint location = this->Location(this->Get<GLint>());
+                this->program = current;
+
+                if (call == CUT_GL_ProgramUniform1i) glProgramUniform1i(program, location, this->Get<GLint>());
+                else glProgramUniform1f(program, location, this->Get<GLfloat>());
+                break;
+            }
+            case CUT_GL_Uniform2fv:
+            case CUT_GL_Uniform3fv:
+            case CUT_GL_Uniform4fv:
+            case CUT_GL_UniformMatrix2fv:
+            case CUT_GL_UniformMatrix3fv:
+            case CUT_GL_UniformMatrix4fv:
+            case CUT_GL_ProgramUniform2fv:
+            case CUT_GL_ProgramUniform3fv:
+            case CUT_GL_ProgramUniform4fv:
+            case CUT_GL_ProgramUniformMatrix2fv:
+            case CUT_GL_ProgramUniformMatrix3fv:
+            case CUT_GL_ProgramUniformMatrix4fv: {
+                auto captured = this->Get<GLuint>();
+                GLuint program = captured ? this->Name(CUT_NAME_PROGRAM, captured) : this->program;
+                GLuint current = this->program;
+                this->program = program;
+                GLint location = this->Location(this->Get<GLint>());
+                this->program = current;
+
+                auto count = this->Get<GLsizei>();
+                auto transpose = this->Get<GLboolean>();
+                int floats;
+                switch (call) {
+                    case CUT_GL_Uniform2fv:
+                    case CUT_GL_ProgramUniform2fv: floats = 2; break;
+                    case CUT_GL_Uniform3fv:
+                    case CUT_GL_ProgramUniform3fv: floats = 3; break;
+                    case CUT_GL_UniformMatrix3fv:
+                    case CUT_GL_ProgramUniformMatrix3fv: floats = 9; break;
+                    case CUT_GL_UniformMatrix4fv:
+                    case CUT_GL_ProgramUniformMatrix4fv: floats = 16; break;
+                    default: floats = 4; break;
+                }
+                uint64_t bytes = count > 0 ? (uint64_t) count * floats * sizeof(GLfloat) : 0;
+                auto value = (GLfloat const *) this->Payload(this->Get<uint32_t>(), bytes);
+                if (!value) break;
+
+                switch (call) {
+                    case CUT_GL_Uniform2fv: glUniform2fv(location, count, value); break;
+                    case CUT_GL_Uniform3fv: glUniform3fv(location, count, value); break;
+                    case CUT_GL_Uniform4fv: glUniform4fv(location, count, value); break;
+                    case CUT_GL_UniformMatrix2fv: glUniformMatrix2fv(location, count, transpose, value); break;
+                    case CUT_GL_UniformMatrix3fv: glUniformMatrix3fv(location, count, transpose, value); break;
+                    case CUT_GL_UniformMatrix4fv: glUniformMatrix4fv(location, count, transpose, value); break;
+                    case CUT_GL_ProgramUniform2fv: glProgramUniform2fv(program, location, count, value); break;
+                    case CUT_GL_ProgramUniform3fv: glProgramUniform3fv(program, location, count, value); break;
+                    case CUT_GL_ProgramUniform4fv: glProgramUniform4fv(program, location, count, value); break;
+                    case CUT_GL_ProgramUniformMatrix2fv: glProgramUniformMatrix2fv(program, location, count, transpose, value); break;
+                    case CUT_GL_ProgramUniformMatrix3fv: glProgramUniformMatrix3fv(program, location, count, transpose, value); break;
+                    default: glProgramUniformMatrix4fv(program, location, count, transpose, value); break;
+                }
+                break;
+            }
+
+            case CUT_GL_Enable: glEnable(this->Get<GLenum>()); break;
+            case CUT_GL_Disable: glDisable(this->Get<GLenum>()); break;
+            case CUT_GL_BlendFunc: {
+                auto source = this->Get<GLenum>();
+                glBlendFunc(source, this->Get<GLenum>());
+                break;
+            }
+            case CUT_GL_DepthMask: glDepthMask(this->Get<GLboolean>()); break;
+            case CUT_GL_DepthFunc: glDepthFunc(this->Get<GLenum>()); break;
+            case CUT_GL_CullFace: glCullFace(this->Get<GLenum>()); break;
+            case CUT_GL_Viewport: {
+                auto x = this->Get<GLint>();
+                auto y = this->Get<GLint>();
+                auto width = this->Get<GLsizei>();
+                glViewport(x, y, width, this->Get<GLsizei>());
+                break;
+            }
+            case CUT_GL_ClearColor: {
+                auto color = this->Get<glm::vec4>();
+                glClearColor(color.r, color.g, color.b, color.a);
+                break;
+            }
+            case CUT_GL_Clear: glClear(this->Get<GLbitfield>()); break;
+
+            case CUT_GL_DrawArrays: {
+                auto mode = this->Get<GLenum>();
+                auto first = this->Get<GLint>();
+                glDrawArrays(mode, first, this->Get<GLsizei>());
+                break;
+            }
+            case CUT_GL_DrawElements:
+            case CUT_GL_DrawElementsBaseVertex:
+            case CUT_GL_DrawElementsInstanced:
+            case CUT_GL_DrawElementsInstancedBaseVertex:
+            case CUT_GL_DrawElementsInstancedBaseVertexBaseInstance: {
+                auto mode = this->Get<GLenum>();
+                auto count = this->Get<GLsizei>();
+                auto type = this->Get<GLenum>();
+                auto indices = (void const *) (uintptr_t) this->Get<uint64_t>();
+                auto instances = this->Get<GLsizei>();
+                auto baseVertex = this->Get<GLint>();
+                auto baseInstance = this->Get<GLuint>();
+
+                // every draw goes back through the call it was made with, the context may not have the others
+                switch (call) {
+                    case CUT_GL_DrawElements: glDrawElements(mode, count, type, indices); break;
+                    case CUT_GL_DrawElementsBaseVertex: glDrawElementsBaseVertex(mode, count, type, indices, baseVertex); break;
+                    case CUT_GL_DrawElementsInstanced: glDrawElementsInstanced(mode, count, type, indices, instances); break;
+                    case CUT_GL_DrawElementsInstancedBaseVertex:
+                        glDrawElementsInstancedBaseVertex(mode, count, type, indices, instances, baseVertex);
+                        break;
+                    default:
+                        glDrawElementsInstancedBaseVertexBaseInstance(mode, count, type, indices, instances, baseVertex, baseInstance);
+                        break;
+                }
+                break;
+            }
+            case CUT_GL_MultiDrawElementsIndirect: {
+                auto mode = this->Get<GLenum>();
+                auto type = this->Get<GLenum>();
+                auto indirect = this->Get<uint64_t>();
+                auto drawCount = this->Get<GLsizei>();
+                auto stride = this->Get<GLsizei>();
+
+                // the commands come out of the bound indirect buffer, and drivers don't all check they fit
+                GLint64 size = 0;
+                glGetBufferParameteri64v(GL_DRAW_INDIRECT_BUFFER, GL_BUFFER_SIZE, &size);
+                uint64_t command = 5 * sizeof(GLuint);
+                uint64_t step = stride > 0 ? (uint64_t) stride : command;
+                uint64_t room = size > 0 && (uint64_t) size > indirect ? (uint64_t) size - indirect : 0;
+                if (drawCount < 0 || stride < 0 || (drawCount > 0 && (room < command || (uint64_t) (drawCount - 1) > (room - command) / step))) {
+                    std::cout << "GL capture draws past its indirect buffer" << std::endl;
+                    throw CUT_ERROR_BAD_CAPTURE;
+                }
+                glMultiDrawElementsIndirect(mode, type, (void const *) (uintptr_t) indirect, drawCount, stride);
+                break;
+            }
+
+            case CUT_GL_FenceSync: {
+                auto condition = this->Get<GLenum>();
+                auto flags = this->Get<GLbitfield>();
+                this->syncs[this->Get<uint64_t>()] = glFenceSync(condition, flags);
+                break;
+            }
+            case CUT_GL_ClientWaitSync: {
+                GLsync sync = this->syncs[this->Get<uint64_t>()];
+                auto flags = this->Get<GLbitfield>();
+                // the capture only has the wait that went through, so wait just as long
+                if (sync) while (glClientWaitSync(sync, flags, 1000000) == GL_TIMEOUT_EXPIRED);
+                break;
+            }
+            case CUT_GL_DeleteSync: {
+                auto captured = this->Get<uint64_t>();
+                GLsync sync = this->syncs[captured];
+                if (sync) glDeleteSync(sync);
+                this->syncs.erase(captured);
+                break;
+            }
+
+            default:
+                std::cout << "Unknown call " << (int) call << " in GL capture, stopping the replay" << std::endl;
+                this->cursor = end;
+                break;
+        }
+    }
+}
@@ -0,0 +1,187 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_GLCAPTURE_H
+#define CUTLASS_GLCAPTURE_H
+
+#include <common.h>
+
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+/*
+ * what one frame asked of GL, counted at the glad function pointers, so it's everything that reached the driver.
+ * the same scene always gives the same numbers, unlike timings.
+ */
+struct GLCaptureStats {
+    uint32_t calls = 0;
+    uint32_t draws = 0;
+    // draws inside multi draw indirect calls
+    uint32_t indirectDraws = 0;
+    uint32_t binds = 0;
+    uint32_t stateChanges = 0;
+    uint32_t uniformUploads = 0;
+    uint32_t bufferUploads = 0;
+    uint64_t bytesUploaded = 0;
+};
+
+/*
+ * a buffer, texture or string a call passed to GL. every distinct payload is kept once, calls refer to it by index.
+ */
+struct GLCapturePayload {
+    uint64_t hash = 0;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+// where a frame's calls are in the stream
+struct GLCaptureFrame {
+    uint64_t begin = 0;
+    uint64_t end = 0;
+};
+
+/*
+ * a recorded session: the calls, one after the other, the payloads they refer to and where each frame is
+ */
+struct GLCaptureData {
+    std::vector<uint8_t> stream;
+    std::vector<GLCaptureFrame> frames;
+    std::vector<GLCapturePayload> payloads;
+    std::vector<uint8_t> blob;
+
+    bool Save(const char *path) const;
+    bool Load(const char *path);
+};
+
+/*
+ * records GL calls into a compact binary stream by swapping the glad function pointers for ones that write the call
+ * down and pass it on. everything the engine uses is covered; queries go straight through and aren't recorded.
+ *
+ * install it right after GL is loaded, so the stream has every object the frames use. BeginFrame() and EndFrame()
+ * mark frames and count them. only for the thread that owns the context.
+ *
+ * writes into persistent mappings happen without any GL call, so StreamBuffer doesn't map persistently while this
+ * is installed.
+ */
+class GLCapture {
+public:
+    void Install();
+    void Uninstall();
+    bool Installed() const { return this->installed; }
+
+    void BeginFrame();
+    // the frame's counts
+    GLCaptureStats EndFrame();
+
+    std::vector<GLCaptureStats> const &Frames() const { return this->frames; }
+    GLCaptureData const &Data() const { return this->data; }
+
+private:
+    friend struct GLCaptureHooks;
+
+    struct Mapping {
+        uint8_t *memory;
+        GLsizeiptr length;
+        GLbitfield access;
+    };
+
+    bool installed = false;
+    bool inFrame = false;
+    GLCaptureData data;
+    std::unordered_map<uint64_t, uint32_t> payloadIndex;
+    std::vector<GLCaptureStats> frames;
+    GLCaptureStats stats;
+
+    std::unordered_map<GLenum, Mapping> mappings;
+    GLint unpackAlignment = 4;
+
+    template<class T>
+    void Put(T const &value) {
+        auto bytes = (uint8_t const *) &value;
+        this->data.stream.insert(this->data.stream.end(), bytes, bytes + sizeof(T));
+    }
+
+    void Call(uint8_t id);
+    uint32_t Payload(void const *memory, uint64_t size);
+};
+
+extern GLCapture glCapture;
+
+/*
+ * plays a capture back on whatever context is current. objects are created again and every name in the stream is
+ * translated to the new one, so it doesn't matter what the context already has.
+ *
+ *     replay.Load(path);
+ *     replay.Setup();                 // everything before the first frame: buffers, textures, shaders
+ *     for (...) replay.ReplayFrame(i);
+ *
+ * framebuffers the capture didn't create were the recording context's own, they become defaultFramebuffer.
+ */
+class GLReplay {
+public:
+    bool Load(const char *path);
+    void Load(GLCaptureData const &capture);
+
+    size_t FrameCount() const { return this->data.frames.size(); }
+
+    void Setup();
+    void ReplayFrame(size_t frame);
+
+    GLuint defaultFramebuffer = 0;
+
+    // names the stream used that it never created, and that aren't the default framebuffer
+    uint32_t UnknownNames() const { return this->unknownNames; }
+
+private:
+    enum NameKind {
+        CUT_NAME_BUFFER,
+        CUT_NAME_TEXTURE,
+        CUT_NAME_VERTEX_ARRAY,
+        CUT_NAME_FRAMEBUFFER,
+        CUT_NAME_RENDERBUFFER,
+        CUT_NAME_SAMPLER,
+        CUT_NAME_SHADER,
+        CUT_NAME_PROGRAM,
+        CUT_NAME_KINDS
+    };
+
+    GLCaptureData data;
+
+    std::unordered_map<GLuint, GLuint> names[CUT_NAME_KINDS];
+    // (live program << 32 | captured location) to live location
+    std::unordered_map<uint64_t, GLint> locations;
+    std::unordered_map<uint64_t, GLsync> syncs;
+    GLuint program = 0;
+    // what glTexImage2D steps rows by, to know how many bytes it'll read
+    GLint unpackAlignment = 4;
+    uint32_t unknownNames = 0;
+
+    size_t cursor = 0;
+    // where the calls being run stop, nothing is read past it
+    size_t end = 0;
+
+    template<class T>
+    T Get() {
+        T value;
+        this->Need(sizeof(T));
+        std::memcpy(&value, this->data.stream.data() + this->cursor, sizeof(T));
+        this->cursor += sizeof(T);
+        return value;
+    }
+
+    void Need(size_t bytes) const;
+    // null for CUT_NO_PAYLOAD. throws when the index is out of the table or the payload is smaller than size
+    uint8_t const *Payload(uint32_t index, uint64_t size = 0) const;
+    uint64_t PayloadSize(uint32_t index) const;
+    // a payload that holds a whole nul terminated string
+    GLchar const *String(uint32_t index) const;
+    GLuint Name(NameKind kind, GLuint captured);
+    void Created(NameKind kind, GLuint captured, GLuint live);
+    GLint Location(GLint captured);
+
+    void Run(size_t begin, size_t end);
+};
+
+#endif //CUTLASS_GLCAPTURE_H
@@ -0,0 +1,171 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "GLState.h"
+
+#include <cassert>
+
+GLState glState;
+
+void GLState::Invalidate() {
+    this->program = CUT_GL_UNKNOWN;
+    this->vertexArray = CUT_GL_UNKNOWN;
+    this->arrayBuffer = CUT_GL_UNKNOWN;
+    this->uniformBuffer = CUT_GL_UNKNOWN;
+    for (GLuint &buffer : this->otherBuffers) buffer = CUT_GL_UNKNOWN;
+    for (BufferRange &range : this->uniformRanges) range = {CUT_GL_UNKNOWN, 0, 0};
+
+    this->activeUnit = CUT_GL_UNKNOWN;
+    for (int i = 0; i < CUT_GL_TEXTURE_UNITS; ++i) {
+        this->textures[i] = CUT_GL_UNKNOWN;
+        this->textureTargets[i] = 0;
+        this->samplers[i] = CUT_GL_UNKNOWN;
+    }
+
+    this->blend = -1;
+    this->blendSource = 0;
+    this->blendDestination = 0;
+    this->depthTest = -1;
+    this->depthWrite = -1;
+    this->depthFunc = 0;
+    this->cull = -1;
+    this->cullFace = 0;
+    this->viewport[0] = this->viewport[1] = this->viewport[2] = this->viewport[3] = -1;
+}
+
+void GLState::UseProgram(GLuint program) {
+    if (!this->Changed(this->program != program)) return;
+    glUseProgram(program);
+    this->program = program;
+}
+
+void GLState::BindVertexArray(GLuint vertexArray) {
+    if (!this->Changed(this->vertexArray != vertexArray)) return;
+    glBindVertexArray(vertexArray);
+    this->vertexArray = vertexArray;
+}
+
+GLuint *GLState::BufferSlot(GLenum target) {
+    switch (target) {
+        case GL_ARRAY_BUFFER: return &this->arrayBuffer;
+        case GL_UNIFORM_BUFFER: return &this->uniformBuffer;
+        case GL_COPY_READ_BUFFER: return &this->otherBuffers[0];
+        case GL_COPY_WRITE_BUFFER: return &this->otherBuffers[1];
+        case GL_PIXEL_PACK_BUFFER: return &this->otherBuffers[2];
+        case GL_DRAW_INDIRECT_BUFFER: return &this->otherBuffers[3];
+        default: return nullptr;
+    }
+}
+
+void GLState::BindBuffer(GLenum target, GLuint buffer) {
+
+    /*
+     * the element array binding belongs to the bound VAO, so it isn't tracked here and always goes through
+     */
+    GLuint *slot = this->BufferSlot(target);
+    if (!this->Changed(!slot || *slot != buffer)) return;
+    glBindBuffer(target, buffer);
+    if (slot) *slot = buffer;
+}
+
+void GLState::BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    if (target != GL_UNIFORM_BUFFER || index >= CUT_GL_UNIFORM_BINDINGS) {
+        ++this->stats.calls;
+        glBindBufferRange(target, index, buffer, offset, size);
+        if (GLuint *slot = this->BufferSlot(target)) *slot = buffer;
+        return;
+    }
+
+    BufferRange &range = this->uniformRanges[index];
+    if (!this->Changed(range.buffer != buffer || range.offset != offset || range.size != size)) return;
+    glBindBufferRange(target, index, buffer, offset, size);
+    range = {buffer, offset, size};
+
+    // binding a range binds the generic target too
+    this->uniformBuffer = buffer;
+}
+
+void GLState::ActiveTexture(GLuint unit) {
+    if (this->activeUnit == unit) return;
+    glActiveTexture(GL_TEXTURE0 + unit);
+    this->activeUnit = unit;
+}
+
+void GLState::BindTexture(GLuint unit, GLenum target, GLuint texture) {
+    assert(unit < CUT_GL_TEXTURE_UNITS);
+    if (!this->Changed(this->textures[unit] != texture || this->textureTargets[unit] != target)) return;
+    this->ActiveTexture(unit);
+    glBindTexture(target, texture);
+    this->textures[unit] = texture;
+    this->textureTargets[unit] = target;
+}
+
+void GLState::BindSampler(GLuint unit, GLuint sampler) {
+    assert(unit < CUT_GL_TEXTURE_UNITS);
+    if (!this->Changed(this->samplers[unit] != sampler)) return;
+    glBindSampler(unit, sampler);
+    this->samplers[unit] = sampler;
+}
+
+void GLState::Enable(GLenum capability, bool enabled) {
+    if (enabled) glEnable(capability);
+    else glDisable(capability);
+}
+
+void GLState::SetBlend(bool enabled, GLenum source, GLenum destination) {
+    if (this->Changed(this->blend != (int) enabled)) {
+        Enable(GL_BLEND, enabled);
+        this->blend = enabled;
+    }
+
+    // the blend function doesn't matter while blending is off, so leave it for when it's turned on
+    if (!enabled) return;
+    if (this->Changed(this->blendSource != source || this->blendDestination != destination)) {
+        glBlendFunc(source, destination);
+        this->blendSource = source;
+        this->blendDestination = destination;
+    }
+}
+
+void GLState::SetDepth(bool test, bool write, GLenum func) {
+    if (this->Changed(this->depthTest != (int) test)) {
+        Enable(GL_DEPTH_TEST, test);
+        this->depthTest = test;
+    }
+    if (this->Changed(this->depthWrite != (int) write)) {
+        glDepthMask(write ? GL_TRUE : GL_FALSE);
+        this->depthWrite = write;
+    }
+    if (test && this->Changed(this->depthFunc != func)) {
+        glDepthFunc(func);
+        this->depthFunc = func;
+    }
+}
+
+void GLState::SetCull(bool enabled, GLenum face) {
+    if (this->Changed(this->cull != (int) enabled)) {
+        Enable(GL_CULL_FACE, enabled);
+        this->cull = enabled;
+    }
+    if (enabled && this->Changed(this->cullFace != face)) {
+        glCullFace(face);
+        this->cullFace = face;
+    }
+}
+
+void GLState::SetViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    bool changed = this->viewport[0] != x || this->viewport[1] != y || this->viewport[2] != width || this->viewport[3] != height;
+    if (!this->Changed(changed)) return;
+    glViewport(x, y, width, height);
+    this->viewport[0] = x;
+    this->viewport[1] = y;
+    this->viewport[2] = width;
+    this->viewport[3] = height;
+}
+
+GLStateStats GLState::BeginFrame() {
+    GLStateStats last = this->stats;
+    this->stats = GLStateStats();
+    return last;
+}
@@ -0,0 +1,104 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_GLSTATE_H
+#define CUTLASS_GLSTATE_H
+
+#include <common.h>
+
+#include <cstdint>
+
+#define CUT_GL_TEXTURE_UNITS 16
+#define CUT_GL_UNIFORM_BINDINGS 16
+
+/*
+ * how many state calls the engine made this frame, and how many never reached the driver because the state was
+ * already set
+ */
+struct GLStateStats {
+    uint32_t calls = 0;
+    uint32_t elided = 0;
+};
+
+/*
+ * shadow copy of the GL state the engine touches. every engine bind and enable goes through here, and calls that
+ * wouldn't change anything are dropped. only for the thread that owns the context.
+ *
+ * deleting a bound object, or changing state behind its back, has to be followed by Invalidate().
+ */
+class GLState {
+public:
+    GLState() { this->Invalidate(); }
+
+    // forget everything, the next call of each kind always goes through
+    void Invalidate();
+
+    void UseProgram(GLuint program);
+    void BindVertexArray(GLuint vertexArray);
+    void BindBuffer(GLenum target, GLuint buffer);
+    void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+    void BindTexture(GLuint unit, GLenum target, GLuint texture);
+    void BindSampler(GLuint unit, GLuint sampler);
+
+    void SetBlend(bool enabled, GLenum source = GL_SRC_ALPHA, GLenum destination = GL_ONE_MINUS_SRC_ALPHA);
+    void SetDepth(bool test, bool write, GLenum func = GL_LESS);
+    void SetCull(bool enabled, GLenum face = GL_BACK);
+    void SetViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    // 0 if it isn't known yet
+    GLuint Program() const { return this->program == CUT_GL_UNKNOWN ? 0 : this->program; }
+
+    // starts counting a new frame, returns the last one's counts
+    GLStateStats BeginFrame();
+    GLStateStats const &Stats() const { return this->stats; }
+
+private:
+    // stands in for "unknown" so the first call of each kind always goes through
+    static constexpr GLuint CUT_GL_UNKNOWN = 0xFFFFFFFF;
+
+    struct BufferRange {
+        GLuint buffer;
+        GLintptr offset;
+        GLsizeiptr size;
+    };
+
+    GLuint program;
+    GLuint vertexArray;
+    GLuint arrayBuffer;
+    GLuint uniformBuffer;
+    GLuint otherBuffers[4];
+    BufferRange uniformRanges[CUT_GL_UNIFORM_BINDINGS];
+
+    GLuint activeUnit;
+    GLuint textures[CUT_GL_TEXTURE_UNITS];
+    GLenum textureTargets[CUT_GL_TEXTURE_UNITS];
+    GLuint samplers[CUT_GL_TEXTURE_UNITS];
+
+    int blend;
+    GLenum blendSource;
+    GLenum blendDestination;
+    int depthTest;
+    int depthWrite;
+    GLenum depthFunc;
+    int cull;
+    GLenum cullFace;
+    GLint viewport[4];
+
+    GLStateStats stats;
+
+    // counts the call, and returns true if it has to go through
+    bool Changed(bool changed) {
+        ++this->stats.calls;
+        if (!changed) ++this->stats.elided;
+        return changed;
+    }
+
+    GLuint *BufferSlot(GLenum target);
+    void ActiveTexture(GLuint unit);
+    static void Enable(GLenum capability, bool enabled);
+};
+
+extern GLState glState;
+
+#endif //CUTLASS_GLSTATE_H
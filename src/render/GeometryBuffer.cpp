@@ -0,0 +1,232 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "GeometryBuffer.h"
+#include "render/GLState.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+
+VertexFormat BasicVertexFormat() {
+    VertexFormat format;
+    format.stride = sizeof(Vertex);
+    format.attributeCount = 3;
+    format.attributes[0] = {0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position)};
+    format.attributes[1] = {1, 4, GL_FLOAT, GL_FALSE, offsetof(Vertex, color)};
+    format.attributes[2] = {2, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, texcoord)};
+    return format;
+}
+
+GeometryBuffer::GeometryBuffer(VertexFormat const &format, uint32_t vertexCapacity, uint32_t indexCapacity)
+        : format(format),
+          vertexAllocator(vertexCapacity),
+          indexAllocator(indexCapacity) {
+
+}
+
+void GeometryBuffer::Init() {
+    glGenBuffers(1, &this->vertexBuffer);
+    glGenBuffers(1, &this->indexBuffer);
+
+    glState.BindBuffer(GL_COPY_WRITE_BUFFER, this->vertexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr) this->vertexAllocator.Size() * this->format.stride, nullptr, GL_STATIC_DRAW);
+    glState.BindBuffer(GL_COPY_WRITE_BUFFER, this->indexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr) this->indexAllocator.Size() * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
+
+    this->CreateVertexArray();
+}
+
+void GeometryBuffer::CreateVertexArray() {
+    glGenVertexArrays(1, &this->vertexArray);
+    glState.BindVertexArray(this->vertexArray);
+    glState.BindBuffer(GL_ARRAY_BUFFER, this->vertexBuffer);
+
+    // part of the VAO's state, so it's bound directly
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->indexBuffer);
+
+    for (uint32_t i = 0; i < this->format.attributeCount; ++i) {
+        VertexAttribute const &attribute = this->format.attributes[i];
+        glEnableVertexAttribArray(attribute.location);
+        glVertexAttribPointer(attribute.location, attribute.components, attribute.type, attribute.normalized,
+                              (GLsizei) this->format.stride, (void *) (size_t) attribute.offset);
+    }
+}
+
+void GeometryBuffer::Sync() {
+    uint32_t count = GetMeshCount();
+    if (count == this->meshesSynced) return;
+
+    this->placements.resize(count);
+
+    for (MeshHandle handle = this->meshesSynced; handle < count; ++handle) {
+        Mesh const &mesh = GetMesh(handle);
+        MeshPlacement &placement = this->placements[handle];
+        if (mesh.vertices.empty() || mesh.indices.empty()) continue;
+
+        if (!this->Place(placement, (uint32_t) mesh.vertices.size(), (uint32_t) mesh.indices.size())) {
+            std::cout << "Mesh " << handle << " doesn't fit in the geometry buffer" << std::endl;
+            throw CUT_ERROR_ASSET_LIMIT;
+        }
+
+        glState.BindBuffer(GL_COPY_WRITE_BUFFER, this->vertexBuffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr) placement.vertices.offset * this->format.stride,
+                        (GLsizeiptr) mesh.vertices.size() * sizeof(Vertex), mesh.vertices.data());
+        glState.BindBuffer(GL_COPY_WRITE_BUFFER, this->indexBuffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr) placement.indices.offset * sizeof(unsigned int),
+                        (GLsizeiptr) mesh.indices.size() * sizeof(unsigned int), mesh.indices.data());
+    }
+
+    this->meshesSynced = count;
+}
+
+bool GeometryBuffer::Place(MeshPlacement &placement, uint32_t vertexCount, uint32_t indexCount) {
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        placement.vertices = this->vertexAllocator.Allocate(vertexCount);
+        placement.indices = this->indexAllocator.Allocate(indexCount);
+        if (placement.vertices.Valid() && placement.indices.Valid()) {
+            placement.vertexCount = vertexCount;
+            placement.indexCount = indexCount;
+            return true;
+        }
+
+        bool vertexFailed = !placement.vertices.Valid();
+        bool indexFailed = !placement.indices.Valid();
+        this->vertexAllocator.Free(placement.vertices);
+        this->indexAllocator.Free(placement.indices);
+        placement = MeshPlacement();
+        if (attempt == 2) break;
+
+        /*
+         * compacting is enough if there's room in total, it's just in pieces. otherwise grow to fit. the allocator
+         * rounds a request up to its size class, so even packed, a free range only a little bigger than the mesh
+         * can still be too small; if compacting didn't do it, grow by twice the mesh, which always fits.
+         */
+        uint32_t vertexCapacity = this->vertexAllocator.Size();
+        uint32_t indexCapacity = this->indexAllocator.Size();
+        if (attempt == 0) {
+            if (this->vertexAllocator.FreeStorage() < vertexCount) vertexCapacity = std::max(vertexCapacity * 2, vertexCapacity + vertexCount);
+            if (this->indexAllocator.FreeStorage() < indexCount) indexCapacity = std::max(indexCapacity * 2, indexCapacity + indexCount);
+        }
+        else {
+            if (vertexFailed) vertexCapacity = std::max(vertexCapacity * 2, vertexCapacity + vertexCount * 2);
+            if (indexFailed) indexCapacity = std::max(indexCapacity * 2, indexCapacity + indexCount * 2);
+        }
+        this->Rebuild(vertexCapacity, indexCapacity);
+    }
+    return false;
+}
+
+/*
+ * allocates sizes back to back from a fresh allocator, in the order given. the allocator rounds each request up to
+ * its size class, so this can run out of room even with enough in total; capacity is grown until everything fits.
+ */
+static OffsetAllocator PackRanges(uint32_t capacity, std::vector<uint32_t> const &sizes, std::vector<OffsetAllocation> &packed) {
+    for (;;) {
+        OffsetAllocator allocator(capacity);
+        packed.clear();
+        bool fits = true;
+        for (uint32_t size : sizes) {
+            OffsetAllocation allocation = allocator.Allocate(size);
+            if (!allocation.Valid()) {
+                fits = false;
+                break;
+            }
+            packed.push_back(allocation);
+        }
+        if (fits) return allocator;
+
+        if (capacity > UINT32_MAX / 2) {
+            std::cout << "Ran out of room in the geometry buffer" << std::endl;
+            throw CUT_ERROR_ASSET_LIMIT;
+        }
+        capacity *= 2;
+    }
+}
+
+void GeometryBuffer::Rebuild(uint32_t vertexCapacity, uint32_t indexCapacity) {
+    /*
+     * a fresh allocator hands out ranges back to back, so placing the live meshes in their old order packs them
+     * to the front without changing which comes first. the vertex and index buffers each keep their own order,
+     * they needn't agree.
+     */
+    std::vector<MeshHandle> byVertex;
+    for (MeshHandle mesh = 0; mesh < this->placements.size(); ++mesh) {
+        if (this->placements[mesh].vertexCount) byVertex.push_back(mesh);
+    }
+    std::vector<MeshHandle> byIndex = byVertex;
+    std::sort(byVertex.begin(), byVertex.end(), [&](MeshHandle a, MeshHandle b) {
+        return this->placements[a].vertices.offset < this->placements[b].vertices.offset;
+    });
+    std::sort(byIndex.begin(), byIndex.end(), [&](MeshHandle a, MeshHandle b) {
+        return this->placements[a].indices.offset < this->placements[b].indices.offset;
+    });
+
+    std::vector<uint32_t> vertexSizes, indexSizes;
+    for (MeshHandle mesh : byVertex) vertexSizes.push_back(this->placements[mesh].vertexCount);
+    for (MeshHandle mesh : byIndex) indexSizes.push_back(this->placements[mesh].indexCount);
+
+    // everything is placed before anything is copied, so a buffer that has to grow is only created once
+    std::vector<OffsetAllocation> vertices, indices;
+    OffsetAllocator vertexAllocator = PackRanges(vertexCapacity, vertexSizes, vertices);
+    OffsetAllocator indexAllocator = PackRanges(indexCapacity, indexSizes, indices);
+
+    GLuint vertexBuffer, indexBuffer;
+    glGenBuffers(1, &vertexBuffer);
+    glGenBuffers(1, &indexBuffer);
+
+    glState.BindBuffer(GL_COPY_WRITE_BUFFER, vertexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr) vertexAllocator.Size() * this->format.stride, nullptr, GL_STATIC_DRAW);
+    glState.BindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr) indexAllocator.Size() * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
+
+    glState.BindBuffer(GL_COPY_READ_BUFFER, this->vertexBuffer);
+    glState.BindBuffer(GL_COPY_WRITE_BUFFER, vertexBuffer);
+    for (size_t i = 0; i < byVertex.size(); ++i) {
+        MeshPlacement &placement = this->placements[byVertex[i]];
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                            (GLintptr) placement.vertices.offset * this->format.stride,
+                            (GLintptr) vertices[i].offset * this->format.stride,
+                            (GLsizeiptr) placement.vertexCount * this->format.stride);
+        placement.vertices = vertices[i];
+    }
+
+    glState.BindBuffer(GL_COPY_READ_BUFFER, this->indexBuffer);
+    glState.BindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+    for (size_t i = 0; i < byIndex.size(); ++i) {
+        MeshPlacement &placement = this->placements[byIndex[i]];
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                            (GLintptr) placement.indices.offset * sizeof(unsigned int),
+                            (GLintptr) indices[i].offset * sizeof(unsigned int),
+                            (GLsizeiptr) placement.indexCount * sizeof(unsigned int));
+        placement.indices = indices[i];
+    }
+
+    glDeleteBuffers(1, &this->vertexBuffer);
+    glDeleteBuffers(1, &this->indexBuffer);
+    glDeleteVertexArrays(1, &this->vertexArray);
+    glState.Invalidate();
+
+    this->vertexBuffer = vertexBuffer;
+    this->indexBuffer = indexBuffer;
+    this->vertexAllocator = std::move(vertexAllocator);
+    this->indexAllocator = std::move(indexAllocator);
+    this->CreateVertexArray();
+}
+
+void GeometryBuffer::Bind() {
+    glState.BindVertexArray(this->vertexArray);
+}
+
+void GeometryBuffer::Draw(MeshHandle mesh) const {
+    MeshPlacement const &placement = this->placements[mesh];
+    glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei) placement.indexCount, GL_UNSIGNED_INT,
+                             (void *) ((size_t) placement.indices.offset * sizeof(unsigned int)),
+                             (GLint) placement.vertices.offset);
+}
+
+DrawCommand GeometryBuffer::Command(MeshHandle mesh, GLuint instances, GLuint baseInstance) const {
+    MeshPlacement const &placement = this->placements[mesh];
+    return {placement.indexCount, instances, placement.indices.offset, (GLint) placement.vertices.offset, baseInstance};
+}
@@ -0,0 +1,95 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_GEOMETRYBUFFER_H
+#define CUTLASS_GEOMETRYBUFFER_H
+
+#include <common.h>
+#include "render/AssetRegistry.h"
+#include "render/OffsetAllocator.h"
+
+#define CUT_MAX_VERTEX_ATTRIBUTES 8
+
+struct VertexAttribute {
+    GLuint location;
+    GLint components;
+    GLenum type;
+    GLboolean normalized;
+    uint32_t offset;
+};
+
+struct VertexFormat {
+    uint32_t stride = 0;
+    uint32_t attributeCount = 0;
+    VertexAttribute attributes[CUT_MAX_VERTEX_ATTRIBUTES];
+};
+
+// the layout of Vertex
+VertexFormat BasicVertexFormat();
+
+/*
+ * where a mesh ended up in a GeometryBuffer. counts are in vertices and indices, not bytes.
+ */
+struct MeshPlacement {
+    OffsetAllocation vertices;
+    OffsetAllocation indices;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+};
+
+/*
+ * laid out like GL's DrawElementsIndirectCommand
+ */
+struct DrawCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+/*
+ * all static geometry of one vertex format, suballocated out of one big vertex buffer and one big index buffer,
+ * behind a single VAO. switching meshes is just a different base vertex and first index on the draw call.
+ *
+ * when a mesh doesn't fit, the buffers are compacted if that frees up enough room, and grown if it doesn't. both
+ * copy every live mesh over on the GPU; indices stay mesh relative, so nothing has to be rewritten.
+ */
+class GeometryBuffer {
+public:
+    explicit GeometryBuffer(VertexFormat const &format, uint32_t vertexCapacity = 64 * 1024, uint32_t indexCapacity = 192 * 1024);
+
+    // needs a current context
+    void Init();
+
+    // uploads any meshes registered since the last call
+    void Sync();
+
+    void Bind();
+    void Draw(MeshHandle mesh) const;
+
+    // the indirect command that draws instances of mesh, starting at baseInstance
+    DrawCommand Command(MeshHandle mesh, GLuint instances, GLuint baseInstance) const;
+
+    MeshPlacement const &Placement(MeshHandle mesh) const { return this->placements[mesh]; }
+
+private:
+    VertexFormat format;
+
+    GLuint vertexArray = 0;
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer = 0;
+
+    OffsetAllocator vertexAllocator;
+    OffsetAllocator indexAllocator;
+
+    std::vector<MeshPlacement> placements;
+    uint32_t meshesSynced = 0;
+
+    bool Place(MeshPlacement &placement, uint32_t vertexCount, uint32_t indexCount);
+    void Rebuild(uint32_t vertexCapacity, uint32_t indexCapacity);
+    void CreateVertexArray();
+};
+
+#endif //CUTLASS_GEOMETRYBUFFER_H
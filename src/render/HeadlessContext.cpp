@@ -0,0 +1,139 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "HeadlessContext.h"
+#include "render/GLState.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstdio>
+
+namespace {
+    // releases whatever CreateHeadlessContext got as far as making before it gave up
+    [[noreturn]] void Fail(HeadlessContext &context, const char *message, Error error) {
+        std::cout << message << std::endl;
+        DestroyHeadlessContext(context);
+        throw error;
+    }
+}
+
+void CreateHeadlessContext(HeadlessContext &context, int width, int height) {
+
+    /*
+     * the surfaceless platform needs neither a display server nor a GPU. if the driver doesn't have it, the default
+     * display may still work, e.g. on a desktop with a GPU.
+     */
+    EGLDisplay display = EGL_NO_DISPLAY;
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay) display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (display == EGL_NO_DISPLAY) display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    EGLint major, minor;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+        std::cout << "Failed to initialize EGL" << std::endl;
+        throw CUT_ERROR_NO_HEADLESS;
+    }
+    context.display = display;
+
+    // surfaceless displays have no window configs, only pbuffer ones
+    EGLint configAttributes[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglBindAPI(EGL_OPENGL_API) || !eglChooseConfig(display, configAttributes, &config, 1, &configCount) || !configCount) {
+        Fail(context, "No EGL config for desktop GL", CUT_ERROR_NO_HEADLESS);
+    }
+
+    // same context main() asks GLFW for
+    EGLint contextAttributes[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+    };
+    EGLContext eglContext = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+    if (eglContext != EGL_NO_CONTEXT) context.context = eglContext;
+    if (eglContext == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext)) {
+        Fail(context, "Failed to create a surfaceless GL context", CUT_ERROR_NO_HEADLESS);
+    }
+
+    if (!gladLoadGLLoader((GLADloadproc) eglGetProcAddress)) {
+        Fail(context, "Failed to initialize GLAD", CUT_ERROR_NO_GLAD);
+    }
+
+    /*
+     * there's no default framebuffer without a surface, so everything is drawn into this one
+     */
+    context.width = width;
+    context.height = height;
+
+    glGenRenderbuffers(1, &context.color);
+    glBindRenderbuffer(GL_RENDERBUFFER, context.color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glGenRenderbuffers(1, &context.depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, context.depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+    glGenFramebuffers(1, &context.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, context.framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, context.color);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, context.depth);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        Fail(context, "Headless framebuffer is incomplete", CUT_ERROR_NO_HEADLESS);
+    }
+
+    glState.SetViewport(0, 0, width, height);
+}
+
+void DestroyHeadlessContext(HeadlessContext &context) {
+    if (!context.display) return;
+
+    if (context.context) {
+        // the names are only made once GL is loaded, a context that failed before that has none to delete
+        if (context.framebuffer) glDeleteFramebuffers(1, &context.framebuffer);
+        if (context.color) glDeleteRenderbuffers(1, &context.color);
+        if (context.depth) glDeleteRenderbuffers(1, &context.depth);
+
+        eglMakeCurrent(context.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(context.display, context.context);
+
+        // the next context starts from GL's defaults, not from what this one had set
+        glState.Invalidate();
+    }
+    eglTerminate(context.display);
+    context = HeadlessContext();
+}
+
+std::vector<unsigned char> ReadHeadlessFrame(HeadlessContext const &context) {
+    size_t row = (size_t) context.width * 3;
+    std::vector<unsigned char> pixels(row * context.height);
+    std::vector<unsigned char> flipped(pixels.size());
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, context.framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, context.width, context.height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+    // GL reads bottom row first
+    for (int y = 0; y < context.height; ++y) {
+        std::copy(&pixels[y * row], &pixels[y * row] + row, &flipped[(context.height - 1 - y) * row]);
+    }
+    return flipped;
+}
+
+bool WritePPM(const char *path, unsigned char const *pixels, int width, int height) {
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+
+    fprintf(file, "P6\n%d %d\n255\n", width, height);
+    size_t written = fwrite(pixels, 3, (size_t) width * height, file);
+    fclose(file);
+
+    return written == (size_t) width * height;
+}
@@ -0,0 +1,38 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_HEADLESSCONTEXT_H
+#define CUTLASS_HEADLESSCONTEXT_H
+
+#include <common.h>
+
+#include <vector>
+
+/*
+ * a GL 3.3 core context with no window or display behind it, drawing into a framebuffer object. built on EGL's
+ * surfaceless platform, so it runs anywhere Mesa does, software rendering (llvmpipe) included.
+ */
+struct HeadlessContext {
+    void *display = nullptr;
+    void *context = nullptr;
+
+    GLuint framebuffer = 0;
+    GLuint color = 0;
+    GLuint depth = 0;
+    int width = 0;
+    int height = 0;
+};
+
+// creates the context, makes it current, loads GL and binds the framebuffer. throws CUT_ERROR_NO_HEADLESS, having
+// released anything it had made
+void CreateHeadlessContext(HeadlessContext &context, int width, int height);
+void DestroyHeadlessContext(HeadlessContext &context);
+
+// the framebuffer's colour as rows of RGB, top row first
+std::vector<unsigned char> ReadHeadlessFrame(HeadlessContext const &context);
+
+// writes RGB rows as a binary PPM
+bool WritePPM(const char *path, unsigned char const *pixels, int width, int height);
+
+#endif //CUTLASS_HEADLESSCONTEXT_H
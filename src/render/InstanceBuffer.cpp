@@ -0,0 +1,34 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "InstanceBuffer.h"
+#include "render/GLState.h"
+
+bool InstanceBuffer::Begin(size_t count) {
+    this->instances = nullptr;
+    if (!count) return true;
+
+    StreamAllocation allocation = this->stream->Allocate(count * sizeof(InstanceData), alignof(InstanceData));
+    this->instances = (InstanceData *) allocation.memory;
+    this->offset = allocation.offset;
+    return this->instances != nullptr;
+}
+
+void InstanceBuffer::Bind(size_t first) {
+    glState.BindBuffer(GL_ARRAY_BUFFER, this->stream->Buffer());
+
+    size_t base = this->offset + first * sizeof(InstanceData);
+    for (GLuint column = 0; column < 4; ++column) {
+        GLuint attribute = CUT_INSTANCE_MODEL_ATTRIBUTE + column;
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribPointer(attribute, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                              (void *) (base + offsetof(InstanceData, model) + column * sizeof(glm::vec4)));
+        glVertexAttribDivisor(attribute, 1);
+    }
+
+    glEnableVertexAttribArray(CUT_INSTANCE_TINT_ATTRIBUTE);
+    glVertexAttribPointer(CUT_INSTANCE_TINT_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                          (void *) (base + offsetof(InstanceData, tint)));
+    glVertexAttribDivisor(CUT_INSTANCE_TINT_ATTRIBUTE, 1);
+}
@@ -0,0 +1,43 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_INSTANCEBUFFER_H
+#define CUTLASS_INSTANCEBUFFER_H
+
+#include <common.h>
+#include "render/StreamBuffer.h"
+
+/*
+ * per instance attributes, see basic.instanced.vertex.glsl. the model matrix takes up four attribute slots.
+ */
+#define CUT_INSTANCE_MODEL_ATTRIBUTE 3
+#define CUT_INSTANCE_TINT_ATTRIBUTE 7
+
+struct InstanceData {
+    glm::mat4 model;
+    glm::vec4 tint;
+};
+
+/*
+ * a frame's worth of instance data, written straight into the stream buffer. each instanced draw points the bound
+ * VAO's instance attributes at its own run of it, which works without base instance support.
+ */
+class InstanceBuffer {
+public:
+    void Init(StreamBuffer &stream) { this->stream = &stream; }
+
+    // makes room for count instances, false if the stream buffer is full this frame
+    bool Begin(size_t count);
+    InstanceData &Instance(size_t index) { return this->instances[index]; }
+
+    // points the bound VAO's instance attributes at instances first onwards
+    void Bind(size_t first);
+
+private:
+    StreamBuffer *stream = nullptr;
+    InstanceData *instances = nullptr;
+    GLintptr offset = 0;
+};
+
+#endif //CUTLASS_INSTANCEBUFFER_H
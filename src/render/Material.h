@@ -0,0 +1,28 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_MATERIAL_H
+#define CUTLASS_MATERIAL_H
+
+#include "render/Shader.h"
+#include "render/Texture.h"
+
+#define CUT_MATERIAL_TEXTURES 2
+
+struct Material {
+    Shader shader;
+
+    // variant of shader that reads the model matrix and tint from instance attributes, see InstanceBuffer. without
+    // one the material is always drawn one object at a time.
+    Shader instancedShader;
+    Texture texture[CUT_MATERIAL_TEXTURES];
+
+    // multiplied into the fragment colour, see MaterialUniforms
+    glm::vec4 tint = glm::vec4(1.0f);
+
+    // alpha blended materials are drawn after everything opaque, back to front
+    bool blend = false;
+};
+
+#endif //CUTLASS_MATERIAL_H
@@ -3,3 +3,13 @@
 //
 
 #include "Mesh.h"
+#include "render/GLState.h"
+
+void BindMaterial(const Material *material, bool instanced) {
+    if (instanced) material->instancedShader.Use();
+    else material->shader.Use();
+
+    for (int i = 0; i < CUT_MATERIAL_TEXTURES; ++i) {
+        glState.BindTexture(i, GL_TEXTURE_2D, material->texture[i].ID);
+    }
+}
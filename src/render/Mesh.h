@@ -5,4 +5,29 @@
 #ifndef CUTLASS_MESH_H
 #define CUTLASS_MESH_H
 
+#include <common.h>
+#include "render/Material.h"
+
+/*
+ * matches the attribute layout of basic.vertex.glsl
+ */
+struct Vertex {
+    glm::vec3 position;
+    glm::vec4 color;
+    glm::vec2 texcoord;
+};
+
+/*
+ * CPU-side geometry. it's drawn from a GeometryBuffer once it's registered, see AssetRegistry
+ */
+struct Mesh {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+};
+
+Mesh CreateTriangleMesh();
+Mesh CreateSquareMesh();
+// uses the material's program, or its instanced one, and binds its textures
+void BindMaterial(const Material *material, bool instanced = false);
+
 #endif //CUTLASS_MESH_H
@@ -0,0 +1,242 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "OffsetAllocator.h"
+
+#include <cassert>
+
+/*
+ * sizes map to bins like tiny floats: 5 bits of exponent and 3 of mantissa. allocating rounds the size up so any
+ * range in the bin is big enough, freeing rounds down so the bin never holds a range that's too small.
+ */
+#define CUT_OFFSET_MANTISSA_BITS 3
+#define CUT_OFFSET_MANTISSA_VALUE (1u << CUT_OFFSET_MANTISSA_BITS)
+#define CUT_OFFSET_MANTISSA_MASK (CUT_OFFSET_MANTISSA_VALUE - 1)
+
+static uint32_t HighestBit(uint32_t value) {
+    return 31 - (uint32_t) __builtin_clz(value);
+}
+
+static uint32_t LowestBit(uint32_t value) {
+    return (uint32_t) __builtin_ctz(value);
+}
+
+static uint32_t BinRoundDown(uint32_t size) {
+    if (size < CUT_OFFSET_MANTISSA_VALUE) return size;
+
+    uint32_t mantissaStart = HighestBit(size) - CUT_OFFSET_MANTISSA_BITS;
+    uint32_t exponent = mantissaStart + 1;
+    uint32_t mantissa = (size >> mantissaStart) & CUT_OFFSET_MANTISSA_MASK;
+    return (exponent << CUT_OFFSET_MANTISSA_BITS) | mantissa;
+}
+
+static uint32_t BinRoundUp(uint32_t size) {
+    if (size < CUT_OFFSET_MANTISSA_VALUE) return size;
+
+    uint32_t mantissaStart = HighestBit(size) - CUT_OFFSET_MANTISSA_BITS;
+    uint32_t exponent = mantissaStart + 1;
+    uint32_t mantissa = (size >> mantissaStart) & CUT_OFFSET_MANTISSA_MASK;
+
+    // anything below the mantissa bumps it up a step, which may carry into the exponent
+    if (size & ((1u << mantissaStart) - 1)) ++mantissa;
+    return (exponent << CUT_OFFSET_MANTISSA_BITS) + mantissa;
+}
+
+static uint32_t BinSize(uint32_t bin) {
+    uint32_t exponent = bin >> CUT_OFFSET_MANTISSA_BITS;
+    uint32_t mantissa = bin & CUT_OFFSET_MANTISSA_MASK;
+    if (!exponent) return mantissa;
+    return (mantissa | CUT_OFFSET_MANTISSA_VALUE) << (exponent - 1);
+}
+
+// lowest set bit at or above start, or CUT_OFFSET_NO_SPACE
+static uint32_t LowestBitFrom(uint32_t mask, uint32_t start) {
+    if (start >= 32) return CUT_OFFSET_NO_SPACE;
+    mask &= ~((1u << start) - 1);
+    return mask ? LowestBit(mask) : CUT_OFFSET_NO_SPACE;
+}
+
+OffsetAllocator::OffsetAllocator(uint32_t size, uint32_t maxAllocations)
+        : size(size),
+          maxAllocations(maxAllocations) {
+    this->Reset();
+}
+
+void OffsetAllocator::Reset() {
+    this->freeStorage = 0;
+    this->usedTopBins = 0;
+    for (uint8_t &leaf : this->usedLeafBins) leaf = 0;
+    for (uint32_t &bin : this->bins) bin = CUT_OFFSET_UNUSED;
+
+    this->nodes.assign(this->maxAllocations, Node());
+
+    // popped off the back, so node 0 goes first
+    this->freeNodes.resize(this->maxAllocations);
+    for (uint32_t i = 0; i < this->maxAllocations; ++i) {
+        this->freeNodes[i] = this->maxAllocations - i - 1;
+    }
+
+    if (this->size) this->InsertIntoBin(this->size, 0);
+}
+
+OffsetAllocation OffsetAllocator::Allocate(uint32_t size) {
+    OffsetAllocation allocation;
+    if (!size || this->freeNodes.empty()) return allocation;
+
+    /*
+     * find the smallest bin that's guaranteed to fit: the rounded up bin if it has anything in it, otherwise the
+     * next used bin above it
+     */
+    uint32_t minimumBin = BinRoundUp(size);
+    uint32_t top = minimumBin / CUT_OFFSET_LEAF_BINS;
+    uint32_t leaf = CUT_OFFSET_NO_SPACE;
+
+    if (top < CUT_OFFSET_TOP_BINS && (this->usedTopBins & (1u << top))) {
+        leaf = LowestBitFrom(this->usedLeafBins[top], minimumBin % CUT_OFFSET_LEAF_BINS);
+    }
+    if (leaf == CUT_OFFSET_NO_SPACE) {
+        top = LowestBitFrom(this->usedTopBins, top + 1);
+        if (top == CUT_OFFSET_NO_SPACE) return allocation;
+        leaf = LowestBit(this->usedLeafBins[top]);
+    }
+
+    uint32_t bin = top * CUT_OFFSET_LEAF_BINS + leaf;
+    uint32_t index = this->bins[bin];
+    Node &node = this->nodes[index];
+    uint32_t total = node.size;
+
+    // pop it off the bin's list
+    node.size = size;
+    node.used = true;
+    this->bins[bin] = node.binNext;
+    if (node.binNext != CUT_OFFSET_UNUSED) this->nodes[node.binNext].binPrevious = CUT_OFFSET_UNUSED;
+    this->freeStorage -= total;
+
+    if (this->bins[bin] == CUT_OFFSET_UNUSED) {
+        this->usedLeafBins[top] &= ~(1u << leaf);
+        if (!this->usedLeafBins[top]) this->usedTopBins &= ~(1u << top);
+    }
+
+    /*
+     * give the rest back as a free range right after this one
+     */
+    uint32_t remainder = total - size;
+    if (remainder) {
+        uint32_t rest = this->InsertIntoBin(remainder, node.offset + size);
+
+        Node &split = this->nodes[index];
+        if (split.neighbourNext != CUT_OFFSET_UNUSED) this->nodes[split.neighbourNext].neighbourPrevious = rest;
+        this->nodes[rest].neighbourPrevious = index;
+        this->nodes[rest].neighbourNext = split.neighbourNext;
+        split.neighbourNext = rest;
+    }
+
+    allocation.offset = this->nodes[index].offset;
+    allocation.node = index;
+    return allocation;
+}
+
+void OffsetAllocator::Free(OffsetAllocation allocation) {
+    if (!allocation.Valid()) return;
+
+    uint32_t index = allocation.node;
+    assert(this->nodes[index].used);
+
+    Node node = this->nodes[index];
+    uint32_t offset = node.offset;
+    uint32_t size = node.size;
+
+    // merge with free neighbours on either side
+    if (node.neighbourPrevious != CUT_OFFSET_UNUSED && !this->nodes[node.neighbourPrevious].used) {
+        Node const &previous = this->nodes[node.neighbourPrevious];
+        offset = previous.offset;
+        size += previous.size;
+        uint32_t before = previous.neighbourPrevious;
+        this->RemoveFromBin(node.neighbourPrevious);
+        node.neighbourPrevious = before;
+    }
+
+    if (node.neighbourNext != CUT_OFFSET_UNUSED && !this->nodes[node.neighbourNext].used) {
+        Node const &next = this->nodes[node.neighbourNext];
+        size += next.size;
+        uint32_t after = next.neighbourNext;
+        this->RemoveFromBin(node.neighbourNext);
+        node.neighbourNext = after;
+    }
+
+    this->nodes[index].used = false;
+    this->freeNodes.push_back(index);
+
+    uint32_t merged = this->InsertIntoBin(size, offset);
+    if (node.neighbourNext != CUT_OFFSET_UNUSED) {
+        this->nodes[merged].neighbourNext = node.neighbourNext;
+        this->nodes[node.neighbourNext].neighbourPrevious = merged;
+    }
+    if (node.neighbourPrevious != CUT_OFFSET_UNUSED) {
+        this->nodes[merged].neighbourPrevious = node.neighbourPrevious;
+        this->nodes[node.neighbourPrevious].neighbourNext = merged;
+    }
+}
+
+uint32_t OffsetAllocator::LargestFree() const {
+    if (!this->usedTopBins) return 0;
+
+    uint32_t top = HighestBit(this->usedTopBins);
+    uint32_t leaf = HighestBit(this->usedLeafBins[top]);
+
+    // every range in the bin is at least the bin's size, find the biggest one actually in it
+    uint32_t largest = BinSize(top * CUT_OFFSET_LEAF_BINS + leaf);
+    for (uint32_t index = this->bins[top * CUT_OFFSET_LEAF_BINS + leaf]; index != CUT_OFFSET_UNUSED; index = this->nodes[index].binNext) {
+        if (this->nodes[index].size > largest) largest = this->nodes[index].size;
+    }
+    return largest;
+}
+
+uint32_t OffsetAllocator::InsertIntoBin(uint32_t size, uint32_t offset) {
+    uint32_t bin = BinRoundDown(size);
+    uint32_t top = bin / CUT_OFFSET_LEAF_BINS;
+    uint32_t leaf = bin % CUT_OFFSET_LEAF_BINS;
+
+    if (this->bins[bin] == CUT_OFFSET_UNUSED) {
+        this->usedLeafBins[top] |= 1u << leaf;
+        this->usedTopBins |= 1u << top;
+    }
+
+    uint32_t head = this->bins[bin];
+    uint32_t index = this->freeNodes.back();
+    this->freeNodes.pop_back();
+
+    this->nodes[index] = {offset, size, CUT_OFFSET_UNUSED, head, CUT_OFFSET_UNUSED, CUT_OFFSET_UNUSED, false};
+    if (head != CUT_OFFSET_UNUSED) this->nodes[head].binPrevious = index;
+    this->bins[bin] = index;
+
+    this->freeStorage += size;
+    return index;
+}
+
+void OffsetAllocator::RemoveFromBin(uint32_t index) {
+    Node &node = this->nodes[index];
+
+    if (node.binPrevious != CUT_OFFSET_UNUSED) {
+        this->nodes[node.binPrevious].binNext = node.binNext;
+        if (node.binNext != CUT_OFFSET_UNUSED) this->nodes[node.binNext].binPrevious = node.binPrevious;
+    }
+    else {
+        // it's the head of its bin
+        uint32_t bin = BinRoundDown(node.size);
+        uint32_t top = bin / CUT_OFFSET_LEAF_BINS;
+        uint32_t leaf = bin % CUT_OFFSET_LEAF_BINS;
+
+        this->bins[bin] = node.binNext;
+        if (node.binNext != CUT_OFFSET_UNUSED) this->nodes[node.binNext].binPrevious = CUT_OFFSET_UNUSED;
+
+        if (this->bins[bin] == CUT_OFFSET_UNUSED) {
+            this->usedLeafBins[top] &= ~(1u << leaf);
+            if (!this->usedLeafBins[top]) this->usedTopBins &= ~(1u << top);
+        }
+    }
+
+    this->freeNodes.push_back(index);
+    this->freeStorage -= node.size;
+}
@@ -0,0 +1,75 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_OFFSETALLOCATOR_H
+#define CUTLASS_OFFSETALLOCATOR_H
+
+#include <cstdint>
+#include <vector>
+
+#define CUT_OFFSET_NO_SPACE 0xFFFFFFFF
+
+/*
+ * a range handed out by OffsetAllocator. node is what gets it back.
+ */
+struct OffsetAllocation {
+    uint32_t offset = CUT_OFFSET_NO_SPACE;
+    uint32_t node = CUT_OFFSET_NO_SPACE;
+
+    bool Valid() const { return offset != CUT_OFFSET_NO_SPACE; }
+};
+
+/*
+ * hands out ranges of some other storage (a GPU buffer, usually), it never touches the storage itself.
+ *
+ * TLSF style: free ranges are kept in 256 bins, 32 power of two bins each split into 8 linear steps, with a bitmask
+ * per level so finding a free range that's big enough is a couple of bit scans. allocating and freeing are both
+ * constant time, and freed ranges merge with free neighbours straight away.
+ */
+class OffsetAllocator {
+public:
+    OffsetAllocator(uint32_t size, uint32_t maxAllocations = 64 * 1024);
+
+    void Reset();
+
+    OffsetAllocation Allocate(uint32_t size);
+    void Free(OffsetAllocation allocation);
+
+    uint32_t Size() const { return this->size; }
+    uint32_t FreeStorage() const { return this->freeStorage; }
+
+    // largest single range that could be allocated right now
+    uint32_t LargestFree() const;
+
+private:
+    static constexpr uint32_t CUT_OFFSET_UNUSED = 0xFFFFFFFF;
+    static constexpr int CUT_OFFSET_TOP_BINS = 32;
+    static constexpr int CUT_OFFSET_LEAF_BINS = 8;
+
+    struct Node {
+        uint32_t offset;
+        uint32_t size;
+        uint32_t binPrevious;
+        uint32_t binNext;
+        uint32_t neighbourPrevious;
+        uint32_t neighbourNext;
+        bool used;
+    };
+
+    uint32_t size;
+    uint32_t maxAllocations;
+    uint32_t freeStorage;
+
+    uint32_t usedTopBins;
+    uint8_t usedLeafBins[CUT_OFFSET_TOP_BINS];
+    uint32_t bins[CUT_OFFSET_TOP_BINS * CUT_OFFSET_LEAF_BINS];
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> freeNodes;
+
+    uint32_t InsertIntoBin(uint32_t size, uint32_t offset);
+    void RemoveFromBin(uint32_t node);
+};
+
+#endif //CUTLASS_OFFSETALLOCATOR_H
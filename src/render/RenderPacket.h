@@ -0,0 +1,31 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_RENDERPACKET_H
+#define CUTLASS_RENDERPACKET_H
+
+#include <common.h>
+#include "render/AssetRegistry.h"
+
+#include <cstdint>
+
+/*
+ * one draw, with everything worked out ahead of time. packets are extracted into the frame arena once per frame
+ * and Render doesn't look at anything else.
+ */
+struct RenderPacket {
+    glm::mat4 model;
+    glm::vec4 tint;
+    uint64_t sortKey;
+    MeshHandle mesh;
+    MaterialHandle material;
+};
+
+/*
+ * packs the draw's state into a key that sorts in submission order, see RenderQueue. depth is the view space
+ * distance of the model's origin.
+ */
+uint64_t MakeSortKey(MeshHandle mesh, MaterialHandle material, float depth);
+
+#endif //CUTLASS_RENDERPACKET_H
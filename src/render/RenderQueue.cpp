@@ -0,0 +1,272 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "RenderQueue.h"
+#include "Profiler.h"
+#include "render/GLState.h"
+
+#include <algorithm>
+
+// view space distance that maps to the far end of the depth bits
+#define CUT_SORT_DEPTH_RANGE 16384.0f
+
+#define CUT_SORT_DEPTH_MAX ((1u << CUT_SORT_DEPTH_BITS) - 1)
+#define CUT_SORT_HANDLE_MASK ((1u << CUT_SORT_HANDLE_BITS) - 1)
+#define CUT_SORT_BLENDED (1ull << 63)
+
+uint64_t MakeSortKey(MeshHandle mesh, MaterialHandle material, float depth) {
+    uint64_t program = GetProgramIndex(material);
+    uint64_t state = (program << (2 * CUT_SORT_HANDLE_BITS))
+            | ((uint64_t) (material & CUT_SORT_HANDLE_MASK) << CUT_SORT_HANDLE_BITS)
+            | (mesh & CUT_SORT_HANDLE_MASK);
+    uint64_t quantised = (uint64_t) (std::clamp(depth / CUT_SORT_DEPTH_RANGE, 0.0f, 1.0f) * CUT_SORT_DEPTH_MAX);
+
+    constexpr int stateBits = CUT_SORT_PROGRAM_BITS + 2 * CUT_SORT_HANDLE_BITS;
+    constexpr int unused = 63 - stateBits - CUT_SORT_DEPTH_BITS;
+
+    if (GetMaterial(material).blend) {
+        return CUT_SORT_BLENDED | (((CUT_SORT_DEPTH_MAX - quantised) << stateBits | state) << unused);
+    }
+
+    return ((state << CUT_SORT_DEPTH_BITS) | quantised) << unused;
+}
+
+void RenderQueue::Sort(FrameArena &arena, RenderPacket const *packets, size_t count) {
+    CUT_PROFILE("Sort");
+
+    this->packets = packets;
+    this->count = count;
+
+    Entry *entries = arena.Allocate<Entry>(count);
+    Entry *scratch = arena.Allocate<Entry>(count);
+    for (size_t i = 0; i < count; ++i) {
+        entries[i] = {packets[i].sortKey, (uint32_t) i};
+    }
+
+    /*
+     * least significant byte first, one counting pass per byte. bytes that are the same for every key (the unused
+     * low bits, and usually the program) don't change the order, so their pass is skipped.
+     */
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t histogram[256] = {};
+        for (size_t i = 0; i < count; ++i) {
+            ++histogram[(entries[i].key >> shift) & 0xFF];
+        }
+
+        if (count == 0 || histogram[(entries[0].key >> shift) & 0xFF] == count) continue;
+
+        size_t offset = 0;
+        for (size_t &bucket : histogram) {
+            size_t size = bucket;
+            bucket = offset;
+            offset += size;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            scratch[histogram[(entries[i].key >> shift) & 0xFF]++] = entries[i];
+        }
+        std::swap(entries, scratch);
+    }
+
+    this->order = entries;
+}
+
+void RenderQueue::Submit(FrameArena &arena, StreamBuffer &stream, UniformBuffers &uniforms, InstanceBuffer &instances, GeometryBuffer &geometry) {
+    CUT_PROFILE("Submit");
+
+    this->stats = RenderQueueStats();
+    this->stats.packets = (uint32_t) this->count;
+
+    bool indirect = this->indirect && GLAD_GL_VERSION_4_3;
+    bool baseInstance = GLAD_GL_VERSION_4_2;
+
+    /*
+     * runs of the same mesh and material are next to each other after sorting. runs of materials that have an
+     * instanced variant become one instanced draw, if they're long enough or if they're going out indirectly anyway;
+     * everything else is drawn one packet at a time.
+     */
+    Batch *batches = arena.Allocate<Batch>(this->count);
+    size_t batchCount = 0;
+    size_t instanceCount = 0;
+    size_t singleCount = 0;
+
+    for (size_t i = 0; i < this->count;) {
+        RenderPacket const &first = this->packets[this->order[i].index];
+        size_t end = i + 1;
+        while (end < this->count) {
+            RenderPacket const &packet = this->packets[this->order[end].index];
+            if (packet.mesh != first.mesh || packet.material != first.material) break;
+            ++end;
+        }
+
+        bool instanceable = GetMaterial(first.material).instancedShader.GetID() != 0;
+        if (instanceable && (indirect || end - i >= CUT_MIN_INSTANCES)) {
+            batches[batchCount++] = {(uint32_t) i, (uint32_t) (end - i), (uint32_t) instanceCount, true};
+            instanceCount += end - i;
+        }
+        else {
+            for (size_t j = i; j < end; ++j) {
+                batches[batchCount++] = {(uint32_t) j, 1, (uint32_t) singleCount++, false};
+            }
+        }
+        i = end;
+    }
+
+    /*
+     * group batches into state buckets
+     */
+    Bucket *buckets = arena.Allocate<Bucket>(batchCount);
+    size_t bucketCount = 0;
+    size_t commandCount = 0;
+
+    for (size_t b = 0; b < batchCount; ++b) {
+        Batch const &batch = batches[b];
+        RenderPacket const &packet = this->packets[this->order[batch.begin].index];
+
+        if (bucketCount) {
+            Bucket &last = buckets[bucketCount - 1];
+            Batch const &lastBatch = batches[last.batch];
+            if (lastBatch.instanced == batch.instanced && this->packets[this->order[lastBatch.begin].index].material == packet.material) {
+                ++last.batchCount;
+                if (batch.instanced) ++commandCount;
+                continue;
+            }
+        }
+
+        buckets[bucketCount++] = {(uint32_t) b, 1, (uint32_t) commandCount, batch.instanced};
+        if (batch.instanced) ++commandCount;
+    }
+
+    /*
+     * write everything the GPU reads this frame: draw blocks, instances, and the indirect commands
+     */
+    uniforms.SyncMaterials();
+    geometry.Sync();
+
+    DrawCommand *commands = nullptr;
+    GLintptr commandOffset = 0;
+    if (indirect && commandCount) {
+        StreamAllocation allocation = stream.Allocate(commandCount * sizeof(DrawCommand), alignof(DrawCommand));
+        commands = (DrawCommand *) allocation.memory;
+        commandOffset = allocation.offset;
+    }
+    else {
+        commands = arena.Allocate<DrawCommand>(commandCount);
+    }
+
+    if (!commands || !uniforms.BeginDraws(singleCount) || !instances.Begin(instanceCount)) {
+        // the stream buffer grows before the next frame, this one just goes without
+        stream.Commit();
+        return;
+    }
+
+    size_t command = 0;
+    for (size_t b = 0; b < batchCount; ++b) {
+        Batch const &batch = batches[b];
+        for (uint32_t i = 0; i < batch.count; ++i) {
+            RenderPacket const &packet = this->packets[this->order[batch.begin + i].index];
+            if (batch.instanced) {
+                instances.Instance(batch.slot + i) = {packet.model, packet.tint};
+            }
+            else {
+                uniforms.Draw(batch.slot) = {packet.model, packet.tint};
+            }
+        }
+
+        if (batch.instanced) {
+            MeshHandle mesh = this->packets[this->order[batch.begin].index].mesh;
+            commands[command++] = geometry.Command(mesh, batch.count, batch.slot);
+        }
+    }
+
+    stream.Commit();
+
+    /*
+     * what the same frame would have cost in extraction order, for the stats
+     */
+    uint32_t unsortedChanges = 0;
+    for (size_t i = 0; i < this->count; ++i) {
+        RenderPacket const &packet = this->packets[i];
+        if (i == 0 || packet.material != this->packets[i - 1].material) ++unsortedChanges;
+        if (i == 0 || packet.mesh != this->packets[i - 1].mesh) ++unsortedChanges;
+        if (i == 0 || GetProgramIndex(packet.material) != GetProgramIndex(this->packets[i - 1].material)) ++unsortedChanges;
+    }
+
+    RenderPacket const *previous = nullptr;
+    bool previousInstanced = false;
+    bool blending = false;
+    glState.SetBlend(false);
+    glState.SetDepth(true, true);
+    geometry.Bind();
+
+    // with base instances the attributes only have to be pointed at the instance data once
+    if (instanceCount && (indirect || baseInstance)) instances.Bind(0);
+    if (indirect) glState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, stream.Buffer());
+
+    for (size_t k = 0; k < bucketCount; ++k) {
+        Bucket const &bucket = buckets[k];
+        RenderPacket const &packet = this->packets[this->order[batches[bucket.batch].begin].index];
+        Material const &material = GetMaterial(packet.material);
+
+        if (material.blend && !blending) {
+            glState.SetBlend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glState.SetDepth(true, false);
+            blending = true;
+        }
+
+        if (!previous || packet.material != previous->material || bucket.instanced != previousInstanced) {
+            if (!previous || GetProgramIndex(packet.material) != GetProgramIndex(previous->material)) {
+                ++this->stats.programChanges;
+            }
+            BindMaterial(&material, bucket.instanced);
+            uniforms.BindMaterial(packet.material);
+            ++this->stats.materialChanges;
+        }
+
+        // every mesh lives in the same buffers, a different mesh is just a different range of them
+        for (uint32_t b = bucket.batch; b < bucket.batch + bucket.batchCount; ++b) {
+            RenderPacket const &first = this->packets[this->order[batches[b].begin].index];
+            if (!previous || first.mesh != previous->mesh) ++this->stats.meshChanges;
+            if (bucket.instanced) this->stats.instances += batches[b].count;
+            previous = &first;
+        }
+        previousInstanced = bucket.instanced;
+
+        if (!bucket.instanced) {
+            for (uint32_t b = bucket.batch; b < bucket.batch + bucket.batchCount; ++b) {
+                uniforms.BindDraw(batches[b].slot);
+                geometry.Draw(this->packets[this->order[batches[b].begin].index].mesh);
+                ++this->stats.draws;
+            }
+            continue;
+        }
+
+        if (indirect) {
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (void *) (commandOffset + bucket.command * sizeof(DrawCommand)),
+                                        (GLsizei) bucket.batchCount, 0);
+            this->stats.indirectCommands += bucket.batchCount;
+            ++this->stats.draws;
+            continue;
+        }
+
+        // no multi draw indirect, so issue the same commands one at a time
+        for (uint32_t c = bucket.command; c < bucket.command + bucket.batchCount; ++c) {
+            DrawCommand const &draw = commands[c];
+            void *indices = (void *) ((size_t) draw.firstIndex * sizeof(unsigned int));
+            if (baseInstance) {
+                glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, (GLsizei) draw.count, GL_UNSIGNED_INT, indices,
+                                                              (GLsizei) draw.instanceCount, draw.baseVertex, draw.baseInstance);
+            }
+            else {
+                instances.Bind(draw.baseInstance);
+                glDrawElementsInstancedBaseVertex(GL_TRIANGLES, (GLsizei) draw.count, GL_UNSIGNED_INT, indices,
+                                                  (GLsizei) draw.instanceCount, draw.baseVertex);
+            }
+            ++this->stats.draws;
+        }
+    }
+
+    uint32_t sortedChanges = this->stats.programChanges + this->stats.materialChanges + this->stats.meshChanges;
+    this->stats.avoided = unsortedChanges > sortedChanges ? unsortedChanges - sortedChanges : 0;
+}
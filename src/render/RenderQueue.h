@@ -0,0 +1,97 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_RENDERQUEUE_H
+#define CUTLASS_RENDERQUEUE_H
+
+#include "render/FrameArena.h"
+#include "render/GeometryBuffer.h"
+#include "render/InstanceBuffer.h"
+#include "render/RenderPacket.h"
+#include "render/UniformBuffers.h"
+
+/*
+ * layout of a sort key, high bits first. opaque draws are grouped by state and go front to back within a group,
+ * blended draws go back to front and only fall back to state when depths tie.
+ *
+ *     opaque:  0 | program:8 | material:12 | mesh:12 | depth:24 | unused:7
+ *     blended: 1 | far depth:24 | program:8 | material:12 | mesh:12 | unused:7
+ */
+#define CUT_SORT_DEPTH_BITS 24
+#define CUT_SORT_PROGRAM_BITS 8
+#define CUT_SORT_HANDLE_BITS 12
+
+// shortest run of the same mesh and material that's drawn instanced
+#define CUT_MIN_INSTANCES 2
+
+/*
+ * how many draw calls and state changes a frame needed, how many packets went out as instances (and how many draws
+ * went through multi draw indirect), and how many more state changes the frame would have needed drawn in
+ * extraction order
+ */
+struct RenderQueueStats {
+    uint32_t packets = 0;
+    uint32_t draws = 0;
+    uint32_t indirectCommands = 0;
+    uint32_t instances = 0;
+    uint32_t programChanges = 0;
+    uint32_t materialChanges = 0;
+    uint32_t meshChanges = 0;
+    uint32_t avoided = 0;
+};
+
+/*
+ * sorts a frame's packets by key and submits them, only rebinding what differs from the previous draw.
+ *
+ * with GL 4.3, everything in a state bucket (a run of the same material) goes out as one multi draw indirect call.
+ * each command's base instance doubles as its draw ID: it's where the draw's model matrix and tint are in the
+ * instance data, and the instance attributes fetch them from there. without GL 4.3 the same commands are issued
+ * one by one.
+ */
+class RenderQueue {
+public:
+    // whether buckets are drawn with glMultiDrawElementsIndirect where the context supports it
+    void SetIndirect(bool indirect) { this->indirect = indirect; }
+
+    // radix sorts the packets' keys into draw order. the order is allocated out of the arena
+    void Sort(FrameArena &arena, RenderPacket const *packets, size_t count);
+
+    // batches runs of the same mesh and material into instanced draws, writes every draw's uniforms and instances
+    // into the stream buffer, commits it, then draws. the frame block has to be written already
+    void Submit(FrameArena &arena, StreamBuffer &stream, UniformBuffers &uniforms, InstanceBuffer &instances, GeometryBuffer &geometry);
+
+    RenderQueueStats const &Stats() const { return this->stats; }
+
+private:
+    struct Entry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    // a draw call: begin and count index the sorted order, slot is the first instance or the draw uniform block
+    struct Batch {
+        uint32_t begin;
+        uint32_t count;
+        uint32_t slot;
+        bool instanced;
+    };
+
+    // a run of batches that share all their state. instanced buckets have one command per batch, from command on
+    struct Bucket {
+        uint32_t batch;
+        uint32_t batchCount;
+        uint32_t command;
+        bool instanced;
+    };
+
+    bool indirect = true;
+
+    RenderPacket const *packets = nullptr;
+    Entry const *order = nullptr;
+    size_t count = 0;
+
+    RenderQueueStats stats;
+};
+
+#endif //CUTLASS_RENDERQUEUE_H
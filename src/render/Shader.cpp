@@ -2,17 +2,22 @@
 // Created by Ashley Horton on 11/9/18.
 //
 
-#include "shader.h"
+#include "Shader.h"
 
 #include "common.h"
+#include "Profiler.h"
+#include "render/GLState.h"
+#include "render/UniformBuffers.h"
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 #include <fstream>
 
-const Shader *currentShader;
-
 Shader::Shader(const char *vertexPath, const char *fragmentPath)
 {
+    CUT_PROFILE("LoadShader");
+
     std::string vertexCode;
     std::string fragmentCode;
     std::ifstream vertexFile;
@@ -91,65 +96,207 @@ Shader::Shader(const char *vertexPath, const char *fragmentPath)
     // delete the shaders as they're linked into our program now and no longer necessery
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+
+    this->ReflectUniforms();
+}
+void Shader::ReflectUniforms()
+{
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<char> name((size_t) std::max(maxLength, 1));
+    this->uniforms.clear();
+
+    for (GLint i = 0; i < count; ++i)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(this->ID, (GLuint) i, (GLsizei) name.size(), &length, &size, &type, name.data());
+
+        // arrays are reported as name[0], but looked up by the bare name
+        if (length > 3 && std::strcmp(&name[length - 3], "[0]") == 0) name[length - 3] = '\0';
+
+        // uniforms in blocks don't have a location of their own
+        GLint location = glGetUniformLocation(this->ID, name.data());
+        if (location < 0) continue;
+
+        this->uniforms.push_back({HashUniformName(name.data()), location, type, name.data()});
+    }
+
+    /*
+     * point the program's blocks at the shared binding points
+     */
+    GLint blockCount = 0;
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+    for (GLint i = 0; i < blockCount; ++i)
+    {
+        char blockName[64];
+        glGetActiveUniformBlockName(this->ID, (GLuint) i, sizeof(blockName), nullptr, blockName);
+
+        int binding = UniformBlockBinding(blockName);
+        if (binding < 0)
+        {
+            std::cout << "Program " << this->ID << " has an unknown uniform block: " << blockName << std::endl;
+            continue;
+        }
+        glUniformBlockBinding(this->ID, (GLuint) i, (GLuint) binding);
+    }
+
+    std::sort(this->uniforms.begin(), this->uniforms.end(), [](UniformSlot const &a, UniformSlot const &b) {
+        return a.hash < b.hash;
+    });
+}
+Shader::UniformSlot const *Shader::FindSlot(UniformName name) const
+{
+    auto slot = std::lower_bound(this->uniforms.begin(), this->uniforms.end(), name.hash, [](UniformSlot const &slot, uint32_t hash) {
+        return slot.hash < hash;
+    });
+
+    // a name the program doesn't have can still hash like one it does
+    for (; slot != this->uniforms.end() && slot->hash == name.hash; ++slot)
+    {
+        if (slot->name == name.name) return &*slot;
+    }
+    return nullptr;
 }
+bool Shader::CompatibleType(GLenum declared, GLenum wanted)
+{
+    if (declared == wanted) return true;
+    if (declared == GL_BOOL) return wanted == GL_INT || wanted == GL_FLOAT;
+    if (wanted == GL_BOOL) return declared == GL_INT || declared == GL_FLOAT;
+
+    // every sampler type is set with an int
+    if (wanted == GL_INT)
+    {
+        switch (declared)
+        {
+            case GL_SAMPLER_1D:
+            case GL_SAMPLER_2D:
+            case GL_SAMPLER_3D:
+            case GL_SAMPLER_CUBE:
+            case GL_SAMPLER_2D_SHADOW:
+            case GL_SAMPLER_2D_ARRAY:
+            case GL_SAMPLER_2D_MULTISAMPLE:
+            case GL_SAMPLER_BUFFER:
+            case GL_INT_SAMPLER_2D:
+            case GL_UNSIGNED_INT_SAMPLER_2D:
+                return true;
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+/*
+ * sets a uniform on this program without disturbing whatever program is in use. with GL 4.1 that's a direct call,
+ * before that the program is bound for the call and the current one put back, but only if they differ.
+ */
+#define CUT_SET_UNIFORM(direct, bound, ...) \
+    if (uniform.location < 0) return; \
+    if (GLAD_GL_VERSION_4_1) \
+    { \
+        direct(this->ID, uniform.location, __VA_ARGS__); \
+        return; \
+    } \
+    GLuint current = glState.Program(); \
+    glState.UseProgram(this->ID); \
+    bound(uniform.location, __VA_ARGS__); \
+    glState.UseProgram(current);
+
 void Shader::Use() const
 {
-    glUseProgram(this->ID);
-    currentShader = this;
+    glState.UseProgram(this->ID);
+}
+void Shader::Set(Uniform<int> uniform, int value) const
+{
+    CUT_SET_UNIFORM(glProgramUniform1i, glUniform1i, value)
+}
+void Shader::Set(Uniform<bool> uniform, bool value) const
+{
+    CUT_SET_UNIFORM(glProgramUniform1i, glUniform1i, (int) value)
+}
+void Shader::Set(Uniform<float> uniform, float value) const
+{
+    CUT_SET_UNIFORM(glProgramUniform1f, glUniform1f, value)
+}
+void Shader::Set(Uniform<glm::vec2> uniform, const glm::vec2 &value) const
+{
+    CUT_SET_UNIFORM(glProgramUniform2fv, glUniform2fv, 1, &value[0])
+}
+void Shader::Set(Uniform<glm::vec3> uniform, const glm::vec3 &value) const
+{
+    CUT_SET_UNIFORM(glProgramUniform3fv, glUniform3fv, 1, &value[0])
+}
+void Shader::Set(Uniform<glm::vec4> uniform, const glm::vec4 &value) const
+{
+    CUT_SET_UNIFORM(glProgramUniform4fv, glUniform4fv, 1, &value[0])
+}
+void Shader::Set(Uniform<glm::mat2> uniform, const glm::mat2 &value) const
+{
+    CUT_SET_UNIFORM(glProgramUniformMatrix2fv, glUniformMatrix2fv, 1, GL_FALSE, &value[0][0])
+}
+void Shader::Set(Uniform<glm::mat3> uniform, const glm::mat3 &value) const
+{
+    CUT_SET_UNIFORM(glProgramUniformMatrix3fv, glUniformMatrix3fv, 1, GL_FALSE, &value[0][0])
+}
+void Shader::Set(Uniform<glm::mat4> uniform, const glm::mat4 &value) const
+{
+    CUT_SET_UNIFORM(glProgramUniformMatrix4fv, glUniformMatrix4fv, 1, GL_FALSE, &value[0][0])
 }
-void Shader::SetBool(const std::string &name, bool value) const
+void Shader::SetBool(UniformName name, bool value) const
 {
-    this->SetInt(name, value);
+    this->Set(this->Find<bool>(name), value);
 }
-void Shader::SetInt(const std::string &name, int value) const
+void Shader::SetInt(UniformName name, int value) const
 {
-    glUseProgram(this->ID);
-    glUniform1i(glGetUniformLocation(this->ID, name.c_str()), value);
-    if (currentShader) glUseProgram(currentShader->ID);
+    this->Set(this->Find<int>(name), value);
 }
-void Shader::SetFloat(const std::string &name, float value) const
+void Shader::SetFloat(UniformName name, float value) const
 {
-    glUseProgram(this->ID);
-    glUniform1f(glGetUniformLocation(this->ID, name.c_str()), value);
-    if (currentShader) glUseProgram(currentShader->ID);
+    this->Set(this->Find<float>(name), value);
 }
-void Shader::SetVec2(const std::string &name, const glm::vec2 &value) const
+void Shader::SetVec2(UniformName name, const glm::vec2 &value) const
 {
-    glUniform2fv(glGetUniformLocation(this->ID, name.c_str()), 1, &value[0]);
+    this->Set(this->Find<glm::vec2>(name), value);
 }
-void Shader::SetVec2(const std::string &name, float x, float y) const
+void Shader::SetVec2(UniformName name, float x, float y) const
 {
-    glUniform2f(glGetUniformLocation(this->ID, name.c_str()), x, y);
+    this->Set(this->Find<glm::vec2>(name), glm::vec2(x, y));
 }
-void Shader::SetVec3(const std::string &name, const glm::vec3 &value) const
+void Shader::SetVec3(UniformName name, const glm::vec3 &value) const
 {
-    glUniform3fv(glGetUniformLocation(this->ID, name.c_str()), 1, &value[0]);
+    this->Set(this->Find<glm::vec3>(name), value);
 }
-void Shader::SetVec3(const std::string &name, float x, float y, float z) const
+void Shader::SetVec3(UniformName name, float x, float y, float z) const
 {
-    glUniform3f(glGetUniformLocation(this->ID, name.c_str()), x, y, z);
+    this->Set(this->Find<glm::vec3>(name), glm::vec3(x, y, z));
 }
-void Shader::SetVec4(const std::string &name, const glm::vec4 &value) const
+void Shader::SetVec4(UniformName name, const glm::vec4 &value) const
 {
-    glUniform4fv(glGetUniformLocation(this->ID, name.c_str()), 1, &value[0]);
+    this->Set(this->Find<glm::vec4>(name), value);
 }
-void Shader::SetVec4(const std::string &name, float x, float y, float z, float w) const
+void Shader::SetVec4(UniformName name, float x, float y, float z, float w) const
 {
-    glUniform4f(glGetUniformLocation(this->ID, name.c_str()), x, y, z, w);
+    this->Set(this->Find<glm::vec4>(name), glm::vec4(x, y, z, w));
 }
-void Shader::SetMat2(const std::string &name, const glm::mat2 &mat) const
+void Shader::SetMat2(UniformName name, const glm::mat2 &mat) const
 {
-    glUniformMatrix2fv(glGetUniformLocation(this->ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    this->Set(this->Find<glm::mat2>(name), mat);
 }
-void Shader::SetMat3(const std::string &name, const glm::mat3 &mat) const
+void Shader::SetMat3(UniformName name, const glm::mat3 &mat) const
 {
-    glUniformMatrix3fv(glGetUniformLocation(this->ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    this->Set(this->Find<glm::mat3>(name), mat);
 }
-void Shader::SetMat4(const std::string &name, const glm::mat4 &mat) const
+void Shader::SetMat4(UniformName name, const glm::mat4 &mat) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(this->ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    this->Set(this->Find<glm::mat4>(name), mat);
 }
-GLuint Shader::GetUniformLocation(const std::string &name) const
+GLint Shader::GetUniformLocation(UniformName name) const
 {
-    return glGetUniformLocation(this->ID, name.c_str());
+    UniformSlot const *slot = this->FindSlot(name);
+    return slot ? slot->location : -1;
 }
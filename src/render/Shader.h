@@ -7,26 +7,119 @@
 
 #include "common.h"
 
+#include <cstdint>
+#include <vector>
+
+/*
+ * FNV-1a, usable at compile time so names written in the source cost nothing to look up
+ */
+constexpr uint32_t HashUniformName(const char *name) {
+    uint32_t hash = 2166136261u;
+    while (*name) {
+        hash ^= (uint8_t) *name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/*
+ * a uniform name, hashed where it's written. string literals hash at compile time.
+ */
+struct UniformName {
+    uint32_t hash;
+    const char *name;
+
+    template<size_t N>
+    constexpr UniformName(const char (&name)[N]) : hash(HashUniformName(name)), name(name) {}
+    UniformName(const std::string &name) : hash(HashUniformName(name.c_str())), name(name.c_str()) {}
+};
+
+/*
+ * the GL type a uniform has to be declared with to be set from T
+ */
+template<class T> struct UniformType;
+template<> struct UniformType<int> { static constexpr GLenum value = GL_INT; };
+template<> struct UniformType<bool> { static constexpr GLenum value = GL_BOOL; };
+template<> struct UniformType<float> { static constexpr GLenum value = GL_FLOAT; };
+template<> struct UniformType<glm::vec2> { static constexpr GLenum value = GL_FLOAT_VEC2; };
+template<> struct UniformType<glm::vec3> { static constexpr GLenum value = GL_FLOAT_VEC3; };
+template<> struct UniformType<glm::vec4> { static constexpr GLenum value = GL_FLOAT_VEC4; };
+template<> struct UniformType<glm::mat2> { static constexpr GLenum value = GL_FLOAT_MAT2; };
+template<> struct UniformType<glm::mat3> { static constexpr GLenum value = GL_FLOAT_MAT3; };
+template<> struct UniformType<glm::mat4> { static constexpr GLenum value = GL_FLOAT_MAT4; };
+
+/*
+ * a uniform location resolved once with Shader::Find and reused from then on. setting an invalid handle (the
+ * uniform doesn't exist, was optimised out, or has a different type) does nothing.
+ */
+template<class T>
+struct Uniform {
+    GLint location = -1;
+
+    bool Valid() const { return location >= 0; }
+};
+
 class Shader {
 private:
+    struct UniformSlot {
+        uint32_t hash;
+        GLint location;
+        GLenum type;
+        // the hash finds the slot, the name makes sure it's the right one
+        std::string name;
+    };
+
     unsigned int ID;
+
+    // every active uniform, sorted by hash. names that hash alike end up next to each other
+    std::vector<UniformSlot> uniforms;
+
+    void ReflectUniforms();
+    UniformSlot const *FindSlot(UniformName name) const;
 public:
     Shader() : ID(0) {}
     Shader(const char *vertexPath, const char *fragmentPath);
+    unsigned int GetID() const { return ID; }
     void Use() const;
-    void SetBool(const std::string &name, bool value) const;
-    void SetInt(const std::string &name, int value) const;
-    void SetFloat(const std::string &name, float value) const;
-    void SetVec2(const std::string &name, const glm::vec2 &value) const;
-    void SetVec2(const std::string &name, float x, float y) const;
-    void SetVec3(const std::string &name, const glm::vec3 &value) const;
-    void SetVec3(const std::string &name, float x, float y, float z) const;
-    void SetVec4(const std::string &name, const glm::vec4 &value) const;
-    void SetVec4(const std::string &name, float x, float y, float z, float w) const;
-    void SetMat2(const std::string &name, const glm::mat2 &mat) const;
-    void SetMat3(const std::string &name, const glm::mat3 &mat) const;
-    void SetMat4(const std::string &name, const glm::mat4 &mat) const;
-    GLuint GetUniformLocation(const std::string &name) const;
+
+    template<class T>
+    Uniform<T> Find(UniformName name) const {
+        Uniform<T> uniform;
+        UniformSlot const *slot = this->FindSlot(name);
+        if (slot && CompatibleType(slot->type, UniformType<T>::value)) uniform.location = slot->location;
+        return uniform;
+    }
+
+    /*
+     * typed setters. these never switch programs when the context can set uniforms on a program directly (GL 4.1),
+     * and otherwise only when the program isn't the current one already.
+     */
+    void Set(Uniform<int> uniform, int value) const;
+    void Set(Uniform<bool> uniform, bool value) const;
+    void Set(Uniform<float> uniform, float value) const;
+    void Set(Uniform<glm::vec2> uniform, const glm::vec2 &value) const;
+    void Set(Uniform<glm::vec3> uniform, const glm::vec3 &value) const;
+    void Set(Uniform<glm::vec4> uniform, const glm::vec4 &value) const;
+    void Set(Uniform<glm::mat2> uniform, const glm::mat2 &value) const;
+    void Set(Uniform<glm::mat3> uniform, const glm::mat3 &value) const;
+    void Set(Uniform<glm::mat4> uniform, const glm::mat4 &value) const;
+
+    void SetBool(UniformName name, bool value) const;
+    void SetInt(UniformName name, int value) const;
+    void SetFloat(UniformName name, float value) const;
+    void SetVec2(UniformName name, const glm::vec2 &value) const;
+    void SetVec2(UniformName name, float x, float y) const;
+    void SetVec3(UniformName name, const glm::vec3 &value) const;
+    void SetVec3(UniformName name, float x, float y, float z) const;
+    void SetVec4(UniformName name, const glm::vec4 &value) const;
+    void SetVec4(UniformName name, float x, float y, float z, float w) const;
+    void SetMat2(UniformName name, const glm::mat2 &mat) const;
+    void SetMat3(UniformName name, const glm::mat3 &mat) const;
+    void SetMat4(UniformName name, const glm::mat4 &mat) const;
+    GLint GetUniformLocation(UniformName name) const;
+
+    // samplers are set as ints, bools can be set from either
+    static bool CompatibleType(GLenum declared, GLenum wanted);
 };
 
 #endif //CUTLASS_SHADER_H
@@ -0,0 +1,123 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "StreamBuffer.h"
+#include "Clock.h"
+#include "render/GLCapture.h"
+#include "render/GLState.h"
+
+#include <cassert>
+
+void StreamBuffer::Init(size_t partitionBytes) {
+    this->partitionBytes = partitionBytes;
+    // a capture can't see writes into a persistent mapping, only the flushes of a regular one
+    this->persistent = GLAD_GL_VERSION_4_4 && !glCapture.Installed();
+    this->Create();
+}
+
+void StreamBuffer::Create() {
+    GLsizeiptr size = (GLsizeiptr) (this->partitionBytes * CUT_STREAM_PARTITIONS);
+
+    glGenBuffers(1, &this->buffer);
+    glState.BindBuffer(GL_COPY_WRITE_BUFFER, this->buffer);
+
+    if (this->persistent) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, flags);
+        this->mapped = (unsigned char *) glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags);
+    }
+    else {
+        glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    }
+
+    this->partition = 0;
+}
+
+void StreamBuffer::Destroy() {
+    for (GLsync &fence : this->fences) {
+        if (fence) glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    glDeleteBuffers(1, &this->buffer);
+    this->buffer = 0;
+    this->mapped = nullptr;
+
+    // whatever was bound is gone, and a new buffer may come back under the same name
+    glState.Invalidate();
+}
+
+void StreamBuffer::BeginFrame() {
+    assert(this->committed);
+
+    /*
+     * last frame didn't fit. wait for the GPU to let go of everything and start over twice the size.
+     */
+    if (this->overflowed) {
+        std::cout << "Stream buffer ran out of room, growing to " << this->partitionBytes * 2 / 1024 << "KiB per frame" << std::endl;
+        glFinish();
+        this->Destroy();
+        this->partitionBytes *= 2;
+        this->Create();
+        this->overflowed = false;
+    }
+
+    this->waited = 0.0;
+    GLsync &fence = this->fences[this->partition];
+    if (fence) {
+        Ticks start = ClockNow();
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED);
+        this->waited = TicksToMilliseconds(ClockNow() - start);
+
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    this->head = 0;
+    this->committed = false;
+
+    if (!this->persistent) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+        glState.BindBuffer(GL_COPY_WRITE_BUFFER, this->buffer);
+        this->mapped = (unsigned char *) glMapBufferRange(GL_COPY_WRITE_BUFFER, this->partition * this->partitionBytes,
+                                                          this->partitionBytes, flags);
+    }
+}
+
+StreamAllocation StreamBuffer::Allocate(size_t bytes, size_t alignment) {
+    assert(!this->committed);
+
+    StreamAllocation allocation;
+    size_t start = (this->head + alignment - 1) / alignment * alignment;
+    if (start + bytes > this->partitionBytes) {
+        this->overflowed = true;
+        return allocation;
+    }
+    this->head = start + bytes;
+
+    // the persistent mapping covers every part, the per frame one only this frame's
+    size_t base = this->partition * this->partitionBytes;
+    allocation.memory = this->mapped + (this->persistent ? base : 0) + start;
+    allocation.offset = (GLintptr) (base + start);
+    return allocation;
+}
+
+void StreamBuffer::Commit() {
+    if (this->committed) return;
+    this->committed = true;
+
+    // coherent persistent mappings are visible as they're written
+    if (this->persistent) return;
+
+    glState.BindBuffer(GL_COPY_WRITE_BUFFER, this->buffer);
+    if (this->head) glFlushMappedBufferRange(GL_COPY_WRITE_BUFFER, 0, (GLsizeiptr) this->head);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    this->mapped = nullptr;
+}
+
+void StreamBuffer::EndFrame() {
+    this->Commit();
+    this->fences[this->partition] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    this->partition = (this->partition + 1) % CUT_STREAM_PARTITIONS;
+}
@@ -0,0 +1,78 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_STREAMBUFFER_H
+#define CUTLASS_STREAMBUFFER_H
+
+#include <common.h>
+
+#define CUT_STREAM_PARTITIONS 3
+#define CUT_STREAM_PARTITION_BYTES (4 * 1024 * 1024)
+
+/*
+ * where an allocation went: memory to write to, and the offset to bind it at in StreamBuffer::Buffer()
+ */
+struct StreamAllocation {
+    void *memory = nullptr;
+    GLintptr offset = 0;
+};
+
+/*
+ * one buffer for all data that changes every frame: draw uniforms, instances, anything else written once and
+ * drawn once. it's split in three, a frame writes into one part while the GPU is still reading the other two, and a
+ * fence per part makes sure we never write over something in flight.
+ *
+ * with GL 4.4 (ARB_buffer_storage) the buffer is mapped once, persistently. on older contexts, like the 3.3 one we
+ * create, each frame's part is mapped unsynchronized for the frame, which the fences make just as safe.
+ *
+ *     stream.BeginFrame();
+ *     ... Allocate() and write ...
+ *     stream.Commit();
+ *     ... draw ...
+ *     stream.EndFrame();
+ *
+ * a frame that needs more than a part holds gets failed allocations, and the buffer grows before the next frame.
+ */
+class StreamBuffer {
+public:
+    // needs a current context
+    void Init(size_t partitionBytes = CUT_STREAM_PARTITION_BYTES);
+
+    // waits until the GPU is done with the part this frame writes into
+    void BeginFrame();
+
+    // nullptr memory if the frame's part is full
+    StreamAllocation Allocate(size_t bytes, size_t alignment);
+
+    // makes everything written this frame visible to the GPU. nothing can be allocated after it until the next frame
+    void Commit();
+
+    void EndFrame();
+
+    GLuint Buffer() const { return this->buffer; }
+    bool Persistent() const { return this->persistent; }
+
+    // time BeginFrame spent waiting on the GPU
+    double WaitedMilliseconds() const { return this->waited; }
+
+private:
+    GLuint buffer = 0;
+    bool persistent = false;
+    size_t partitionBytes = 0;
+
+    // the persistent mapping of the whole buffer, or this frame's part while it's mapped
+    unsigned char *mapped = nullptr;
+
+    int partition = 0;
+    size_t head = 0;
+    bool committed = true;
+    bool overflowed = false;
+    GLsync fences[CUT_STREAM_PARTITIONS] = {};
+    double waited = 0.0;
+
+    void Create();
+    void Destroy();
+};
+
+#endif //CUTLASS_STREAMBUFFER_H
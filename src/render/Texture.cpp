@@ -0,0 +1,32 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "Texture.h"
+#include "Profiler.h"
+#include "render/GLState.h"
+
+#include <stb_image.h>
+
+void LoadTexture(Texture *texture, const char *path, GLenum format, GLint wrap, GLint filter) {
+    CUT_PROFILE("LoadTexture");
+
+    unsigned char *data = stbi_load(path, &texture->width, &texture->height, &texture->channels, 0);
+    if (!data) {
+        std::cout << "Failed to load texture: " << path << std::endl;
+        throw CUT_ASSETS_TEXTURE_NOT_READ;
+    }
+
+    glGenTextures(1, &texture->ID);
+    glState.BindTexture(0, GL_TEXTURE_2D, texture->ID);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, format, texture->width, texture->height, 0, format, GL_UNSIGNED_BYTE, data);
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    stbi_image_free(data);
+}
@@ -0,0 +1,19 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_TEXTURE_H
+#define CUTLASS_TEXTURE_H
+
+#include <common.h>
+
+struct Texture {
+    GLuint ID = 0;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+};
+
+void LoadTexture(Texture *texture, const char *path, GLenum format, GLint wrap, GLint filter);
+
+#endif //CUTLASS_TEXTURE_H
@@ -0,0 +1,81 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#include "UniformBuffers.h"
+#include "render/GLState.h"
+
+#include <algorithm>
+#include <cstring>
+
+static size_t AlignUp(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+int UniformBlockBinding(const char *name) {
+    if (std::strcmp(name, "FrameUniforms") == 0) return CUT_FRAME_UNIFORMS;
+    if (std::strcmp(name, "MaterialUniforms") == 0) return CUT_MATERIAL_UNIFORMS;
+    if (std::strcmp(name, "DrawUniforms") == 0) return CUT_DRAW_UNIFORMS;
+    return -1;
+}
+
+void UniformBuffers::Init(StreamBuffer &stream) {
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+
+    this->stream = &stream;
+    this->alignment = (size_t) alignment;
+    this->materialStride = AlignUp(sizeof(MaterialUniforms), this->alignment);
+    this->drawStride = AlignUp(sizeof(DrawUniforms), this->alignment);
+
+    glGenBuffers(1, &this->materialBuffer);
+}
+
+bool UniformBuffers::UploadFrame(FrameUniforms const &frame) {
+    StreamAllocation allocation = this->stream->Allocate(sizeof(FrameUniforms), this->alignment);
+    if (!allocation.memory) return false;
+
+    std::memcpy(allocation.memory, &frame, sizeof(FrameUniforms));
+    glState.BindBufferRange(GL_UNIFORM_BUFFER, CUT_FRAME_UNIFORMS, this->stream->Buffer(), allocation.offset, sizeof(FrameUniforms));
+    return true;
+}
+
+void UniformBuffers::SyncMaterials() {
+    uint32_t count = GetMaterialCount();
+    if (count == this->materialsUploaded) return;
+
+    glState.BindBuffer(GL_UNIFORM_BUFFER, this->materialBuffer);
+
+    // out of room, reallocate and upload every material again
+    if (count > this->materialCapacity) {
+        this->materialCapacity = std::max(count, this->materialCapacity * 2);
+        glBufferData(GL_UNIFORM_BUFFER, this->materialCapacity * this->materialStride, nullptr, GL_STATIC_DRAW);
+        this->materialsUploaded = 0;
+    }
+
+    for (uint32_t i = this->materialsUploaded; i < count; ++i) {
+        MaterialUniforms uniforms = {GetMaterial(i).tint};
+        glBufferSubData(GL_UNIFORM_BUFFER, i * this->materialStride, sizeof(MaterialUniforms), &uniforms);
+    }
+    this->materialsUploaded = count;
+}
+
+void UniformBuffers::BindMaterial(MaterialHandle material) {
+    glState.BindBufferRange(GL_UNIFORM_BUFFER, CUT_MATERIAL_UNIFORMS, this->materialBuffer,
+                      material * this->materialStride, sizeof(MaterialUniforms));
+}
+
+bool UniformBuffers::BeginDraws(size_t count) {
+    this->draws = nullptr;
+    if (!count) return true;
+
+    StreamAllocation allocation = this->stream->Allocate(count * this->drawStride, this->alignment);
+    this->draws = (unsigned char *) allocation.memory;
+    this->drawOffset = allocation.offset;
+    return this->draws != nullptr;
+}
+
+void UniformBuffers::BindDraw(size_t index) {
+    glState.BindBufferRange(GL_UNIFORM_BUFFER, CUT_DRAW_UNIFORMS, this->stream->Buffer(),
+                            this->drawOffset + index * this->drawStride, sizeof(DrawUniforms));
+}
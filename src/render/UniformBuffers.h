@@ -0,0 +1,87 @@
+//
+// Created by Ashley on 10/18/2026.
+//
+
+#ifndef CUTLASS_UNIFORMBUFFERS_H
+#define CUTLASS_UNIFORMBUFFERS_H
+
+#include <common.h>
+#include "render/AssetRegistry.h"
+#include "render/StreamBuffer.h"
+
+#include <cstdint>
+#include <vector>
+
+/*
+ * binding points shared by every program. Shader binds its blocks to these by name when it's linked, so a frame
+ * binds each buffer once and every program sees it.
+ */
+enum UniformBinding {
+    CUT_FRAME_UNIFORMS = 0,
+    CUT_MATERIAL_UNIFORMS = 1,
+    CUT_DRAW_UNIFORMS = 2,
+};
+
+// binding point for a block name, or -1 if it isn't one of ours
+int UniformBlockBinding(const char *name);
+
+/*
+ * std140 layouts of the blocks, see basic.vertex.glsl. only vec4/mat4 members so C++ and std140 agree on padding.
+ */
+struct FrameUniforms {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;
+
+    // x is seconds since start, y the last frame's length
+    glm::vec4 time;
+};
+
+struct MaterialUniforms {
+    glm::vec4 tint;
+};
+
+struct DrawUniforms {
+    glm::mat4 model;
+    glm::vec4 tint;
+};
+
+/*
+ * owns the blocks. material blocks live side by side in one static buffer indexed by handle, and are uploaded as
+ * materials get registered. the frame block and the draw blocks are written straight into the stream buffer and
+ * bound with glBindBufferRange, the frame block once and the draw blocks per draw.
+ */
+class UniformBuffers {
+public:
+    // needs a current context
+    void Init(StreamBuffer &stream);
+
+    // false if the stream buffer is full this frame
+    bool UploadFrame(FrameUniforms const &frame);
+
+    // uploads any materials registered since the last call
+    void SyncMaterials();
+    void BindMaterial(MaterialHandle material);
+
+    // makes room for count draw blocks, false if the stream buffer is full this frame
+    bool BeginDraws(size_t count);
+    DrawUniforms &Draw(size_t index) { return *reinterpret_cast<DrawUniforms *>(this->draws + index * this->drawStride); }
+    void BindDraw(size_t index);
+
+private:
+    StreamBuffer *stream = nullptr;
+    GLuint materialBuffer = 0;
+
+    // sizes rounded up to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+    size_t alignment = 0;
+    size_t materialStride = 0;
+    size_t drawStride = 0;
+
+    uint32_t materialsUploaded = 0;
+    uint32_t materialCapacity = 0;
+
+    unsigned char *draws = nullptr;
+    GLintptr drawOffset = 0;
+};
+
+#endif //CUTLASS_UNIFORMBUFFERS_H
@@ -4,11 +4,15 @@ out vec4 fragment;
 in vec4 color;
 in vec2 texcoord;
 
+layout (std140) uniform MaterialUniforms {
+    vec4 tint;
+};
+
 uniform sampler2D u_texture;
 uniform sampler2D u_texture1;
 
 void main()
 {
     vec4 tex_color = texture(u_texture, texcoord);
-    fragment = color * mix(tex_color, texture(u_texture1, texcoord), tex_color.a * 0.2);
+    fragment = tint * color * mix(tex_color, texture(u_texture1, texcoord), tex_color.a * 0.2);
 }
@@ -0,0 +1,31 @@
+#version 330 core
+layout (std140) uniform FrameUniforms {
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    vec4 time;
+};
+
+layout (location = 0) in vec3 in_position;
+layout (location = 1) in vec4 in_color;
+layout (location = 2) in vec2 in_texcoord;
+
+// per instance, see InstanceBuffer. indirect draws reach their own instances through the base instance, which
+// acts as the draw ID
+layout (location = 3) in mat4 in_model;
+layout (location = 7) in vec4 in_tint;
+
+out vec4 color;
+out vec2 texcoord;
+
+void main()
+{
+    mat4 model_view = view * in_model;
+    vec4 position = projection * model_view * vec4(in_position, 1.0);
+
+    float distance = length(model_view * position);
+
+    gl_Position = position;
+    color = in_color * in_tint;
+    texcoord = in_texcoord * (distance + position.w) / (distance);
+}
@@ -1,6 +1,15 @@
 #version 330 core
-uniform mat4 model_view_projection;
-uniform mat4 model_view;
+layout (std140) uniform FrameUniforms {
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    vec4 time;
+};
+
+layout (std140) uniform DrawUniforms {
+    mat4 model;
+    vec4 draw_tint;
+};
 
 layout (location = 0) in vec3 in_position;
 layout (location = 1) in vec4 in_color;
@@ -11,7 +20,8 @@ out vec2 texcoord;
 
 void main()
 {
-    vec4 position = model_view_projection * vec4(in_position, 1.0);
+    mat4 model_view = view * model;
+    vec4 position = projection * model_view * vec4(in_position, 1.0);
     /*position.xyz = position.xyz / position.w;
     position.x = floor(200.0 * position.x) / 200.0;
     position.y = floor(200.0 * position.y) / 200.0;
@@ -20,6 +30,6 @@ void main()
     float distance = length(model_view * position);
 
     gl_Position = position;
-    color = in_color;
+    color = in_color * draw_tint;
     texcoord = in_texcoord * (distance + position.w) / (distance);
 }